@@ -0,0 +1,324 @@
+#ifndef CIRCUITS_ALGEBRAIC_MULTIGRID_H
+#define CIRCUITS_ALGEBRAIC_MULTIGRID_H
+
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <stdexcept>
+#include "sparse_matrix.h"
+#include "iterative_solver.h"
+
+template <typename T>
+class algebraic_multigrid : public preconditioner<T> {
+public:
+    typedef typename sparse_matrix<T>::index index;
+
+    explicit algebraic_multigrid(const sparse_matrix<T>& matrix_);
+    algebraic_multigrid(const graph& graph_, const std::vector<T>& edge_conductivity, size_t dimension);
+
+    size_t get_level_number() const { return levels.size(); }
+    size_t get_level_size(size_t level_index) const { return levels[level_index].system_matrix.get_row_number(); }
+
+    std::vector<T> apply(const std::vector<T>& residual) const override;
+    std::vector<T> solve(const std::vector<T>& right_side, double tolerance, size_t max_iterations);
+    const solver_statistics& get_statistics() const { return statistics; }
+
+private:
+    struct level {
+        sparse_matrix<T> system_matrix;
+        sparse_matrix<T> prolongator;
+        sparse_matrix<T> restrictor;
+        std::vector<T> inverse_diagonal;
+        double smoothing_weight = 0.;
+    };
+
+    static constexpr index No_aggregate = std::numeric_limits<index>::max();
+    static constexpr size_t Coarsest_size = 64;
+    static constexpr size_t Max_level_number = 25;
+    static constexpr double Strength_threshold = 0.08;
+    static constexpr double Min_coarsening_ratio = 0.9;
+    static constexpr size_t Power_iteration_number = 15;
+
+    std::vector<level> levels;
+    std::unique_ptr<sparse_ldl_factorization<T>> coarsest_factorization;
+    solver_statistics statistics;
+
+    void build_hierarchy(const sparse_matrix<T>& matrix_);
+    void prepare_smoother(level& level_) const;
+    std::vector<std::vector<index>> get_strong_connections(const sparse_matrix<T>& matrix_) const;
+    size_t aggregate(const sparse_matrix<T>& matrix_, std::vector<index>& aggregates) const;
+    sparse_matrix<T> build_prolongator(const level& level_, const std::vector<index>& aggregates,
+                                       size_t aggregate_number) const;
+
+    void smooth(const level& level_, const std::vector<T>& right_side, std::vector<T>& solution,
+                bool is_forward) const;
+    void relax_row(const level& level_, const std::vector<T>& right_side, std::vector<T>& solution,
+                   size_t row_) const;
+    void cycle(size_t level_index, const std::vector<T>& right_side, std::vector<T>& solution) const;
+};
+
+template <typename T>
+algebraic_multigrid<T>::algebraic_multigrid(const sparse_matrix<T>& matrix_) {
+    if (matrix_.get_row_number() != matrix_.get_col_number())
+        throw std::runtime_error("Cannot build multigrid hierarchy");
+    build_hierarchy(matrix_);
+}
+
+template <typename T>
+algebraic_multigrid<T>::algebraic_multigrid(const graph& graph_, const std::vector<T>& edge_conductivity,
+                                            size_t dimension):
+    algebraic_multigrid(sparse_matrix<T>::laplacian(graph_, edge_conductivity, dimension)) {}
+
+template <typename T>
+void algebraic_multigrid<T>::build_hierarchy(const sparse_matrix<T>& matrix_) {
+    levels.emplace_back();
+    levels.back().system_matrix = matrix_;
+    prepare_smoother(levels.back());
+    while (levels.size() < Max_level_number && levels.back().system_matrix.get_row_number() > Coarsest_size) {
+        std::vector<index> aggregates;
+        const size_t aggregate_number = aggregate(levels.back().system_matrix, aggregates);
+        if (!aggregate_number ||
+            aggregate_number > Min_coarsening_ratio * levels.back().system_matrix.get_row_number())
+            break;
+
+        auto& fine_level = levels.back();
+        fine_level.prolongator = build_prolongator(fine_level, aggregates, aggregate_number);
+        fine_level.restrictor = fine_level.prolongator.transpose();
+        auto coarse_matrix = fine_level.restrictor.multiply(fine_level.system_matrix.multiply(fine_level.prolongator));
+        levels.emplace_back();
+        levels.back().system_matrix = std::move(coarse_matrix);
+        prepare_smoother(levels.back());
+    }
+
+    coarsest_factorization = std::make_unique<sparse_ldl_factorization<T>>(levels.back().system_matrix);
+    if (coarsest_factorization->is_singular())
+        coarsest_factorization.reset();
+}
+
+template <typename T>
+void algebraic_multigrid<T>::prepare_smoother(level& level_) const {
+    const auto& system_matrix = level_.system_matrix;
+    const size_t size = system_matrix.get_row_number();
+    level_.inverse_diagonal.assign(size, static_cast<T>(0));
+    for (size_t row_ = 0; row_ < size; row_++) {
+        const T diagonal = system_matrix.get_element(row_, row_);
+        if (diagonal != static_cast<T>(0))
+            level_.inverse_diagonal[row_] = static_cast<T>(1) / diagonal;
+    }
+
+    std::vector<T> power_vector(size);
+    for (size_t row_ = 0; row_ < size; row_++) {
+        power_vector[row_] = static_cast<T>(1. + static_cast<double>((row_ * 7919) % 101) / 101.);
+    }
+    double spectral_radius = 0.;
+    for (size_t iteration = 0; iteration < Power_iteration_number; iteration++) {
+        const double power_vector_norm = euclidean_norm(power_vector);
+        if (power_vector_norm == 0.)
+            break;
+        auto next_vector = system_matrix.multiply(power_vector);
+        for (size_t row_ = 0; row_ < size; row_++) {
+            next_vector[row_] *= level_.inverse_diagonal[row_] / power_vector_norm;
+        }
+        spectral_radius = euclidean_norm(next_vector);
+        power_vector = std::move(next_vector);
+    }
+    level_.smoothing_weight = spectral_radius > 0. ? 4. / (3. * spectral_radius) : 0.;
+}
+
+template <typename T>
+std::vector<std::vector<typename algebraic_multigrid<T>::index>>
+algebraic_multigrid<T>::get_strong_connections(const sparse_matrix<T>& matrix_) const {
+    const auto& row_offsets = matrix_.get_row_offsets();
+    const auto& col_indices = matrix_.get_col_indices();
+    const auto& values = matrix_.get_values();
+    std::vector<double> diagonal(matrix_.get_row_number());
+    for (size_t row_ = 0; row_ < matrix_.get_row_number(); row_++) {
+        diagonal[row_] = std::abs(matrix_.get_element(row_, row_));
+    }
+
+    std::vector<std::vector<index>> strong_connections(matrix_.get_row_number());
+    for (size_t row_ = 0; row_ < matrix_.get_row_number(); row_++) {
+        for (index position = row_offsets[row_]; position < row_offsets[row_ + 1]; position++) {
+            const index col_ = col_indices[position];
+            if (col_ != row_ &&
+                std::abs(values[position]) >= Strength_threshold * std::sqrt(diagonal[row_] * diagonal[col_]))
+                strong_connections[row_].push_back(col_);
+        }
+    }
+    return strong_connections;
+}
+
+template <typename T>
+size_t algebraic_multigrid<T>::aggregate(const sparse_matrix<T>& matrix_, std::vector<index>& aggregates) const {
+    const auto strong_connections = get_strong_connections(matrix_);
+    const size_t size = matrix_.get_row_number();
+    aggregates.assign(size, No_aggregate);
+    size_t aggregate_number = 0;
+
+    for (size_t vertex_ = 0; vertex_ < size; vertex_++) {
+        if (aggregates[vertex_] != No_aggregate || strong_connections[vertex_].empty())
+            continue;
+        bool is_free_neighbourhood = true;
+        for (index neighbour : strong_connections[vertex_]) {
+            is_free_neighbourhood &= aggregates[neighbour] == No_aggregate;
+        }
+        if (!is_free_neighbourhood)
+            continue;
+        aggregates[vertex_] = static_cast<index>(aggregate_number);
+        for (index neighbour : strong_connections[vertex_]) {
+            aggregates[neighbour] = static_cast<index>(aggregate_number);
+        }
+        aggregate_number++;
+    }
+
+    const std::vector<index> root_aggregates(aggregates);
+    for (size_t vertex_ = 0; vertex_ < size; vertex_++) {
+        if (aggregates[vertex_] != No_aggregate)
+            continue;
+        for (index neighbour : strong_connections[vertex_]) {
+            if (root_aggregates[neighbour] != No_aggregate) {
+                aggregates[vertex_] = root_aggregates[neighbour];
+                break;
+            }
+        }
+    }
+
+    for (size_t vertex_ = 0; vertex_ < size; vertex_++) {
+        if (aggregates[vertex_] != No_aggregate)
+            continue;
+        aggregates[vertex_] = static_cast<index>(aggregate_number);
+        for (index neighbour : strong_connections[vertex_]) {
+            if (aggregates[neighbour] == No_aggregate)
+                aggregates[neighbour] = static_cast<index>(aggregate_number);
+        }
+        aggregate_number++;
+    }
+    return aggregate_number;
+}
+
+template <typename T>
+sparse_matrix<T> algebraic_multigrid<T>::build_prolongator(const level& level_, const std::vector<index>& aggregates,
+                                                           size_t aggregate_number) const {
+    std::vector<size_t> aggregate_sizes(aggregate_number, 0);
+    for (index aggregate_index : aggregates) {
+        aggregate_sizes[aggregate_index]++;
+    }
+    std::vector<typename sparse_matrix<T>::triplet> tentative_elements;
+    for (size_t vertex_ = 0; vertex_ < aggregates.size(); vertex_++) {
+        const T element = static_cast<T>(1. / std::sqrt(static_cast<double>(aggregate_sizes[aggregates[vertex_]])));
+        tentative_elements.push_back({static_cast<index>(vertex_), aggregates[vertex_], element});
+    }
+    sparse_matrix<T> tentative(aggregates.size(), aggregate_number, tentative_elements);
+
+    const auto smoothed = level_.system_matrix.multiply(tentative);
+    const auto& row_offsets = smoothed.get_row_offsets();
+    const auto& col_indices = smoothed.get_col_indices();
+    const auto& values = smoothed.get_values();
+    auto prolongator_elements = std::move(tentative_elements);
+    for (size_t row_ = 0; row_ < smoothed.get_row_number(); row_++) {
+        const T scale = level_.smoothing_weight * level_.inverse_diagonal[row_];
+        for (index position = row_offsets[row_]; position < row_offsets[row_ + 1]; position++) {
+            prolongator_elements.push_back({static_cast<index>(row_), col_indices[position], -scale * values[position]});
+        }
+    }
+    return sparse_matrix<T>(aggregates.size(), aggregate_number, prolongator_elements);
+}
+
+template <typename T>
+void algebraic_multigrid<T>::smooth(const level& level_, const std::vector<T>& right_side,
+                                    std::vector<T>& solution, bool is_forward) const {
+    if (is_forward) {
+        for (size_t row_ = 0; row_ < solution.size(); row_++) {
+            relax_row(level_, right_side, solution, row_);
+        }
+        return;
+    }
+    for (size_t row_ = solution.size(); row_-- > 0;) {
+        relax_row(level_, right_side, solution, row_);
+    }
+}
+
+template <typename T>
+void algebraic_multigrid<T>::relax_row(const level& level_, const std::vector<T>& right_side,
+                                       std::vector<T>& solution, size_t row_) const {
+    const auto& row_offsets = level_.system_matrix.get_row_offsets();
+    const auto& col_indices = level_.system_matrix.get_col_indices();
+    const auto& values = level_.system_matrix.get_values();
+    T residual = right_side[row_];
+    for (index position = row_offsets[row_]; position < row_offsets[row_ + 1]; position++) {
+        residual -= values[position] * solution[col_indices[position]];
+    }
+    solution[row_] += level_.inverse_diagonal[row_] * residual;
+}
+
+template <typename T>
+void algebraic_multigrid<T>::cycle(size_t level_index, const std::vector<T>& right_side,
+                                   std::vector<T>& solution) const {
+    const auto& current_level = levels[level_index];
+    if (level_index + 1 == levels.size()) {
+        if (coarsest_factorization) {
+            solution = coarsest_factorization->solve(right_side);
+            return;
+        }
+        for (size_t sweep = 0; sweep < Coarsest_size; sweep++) {
+            smooth(current_level, right_side, solution, true);
+            smooth(current_level, right_side, solution, false);
+        }
+        return;
+    }
+
+    smooth(current_level, right_side, solution, true);
+    auto residual = current_level.system_matrix.multiply(solution);
+    for (size_t row_ = 0; row_ < residual.size(); row_++) {
+        residual[row_] = right_side[row_] - residual[row_];
+    }
+    const auto coarse_right_side = current_level.restrictor.multiply(residual);
+    std::vector<T> coarse_solution(coarse_right_side.size(), static_cast<T>(0));
+    cycle(level_index + 1, coarse_right_side, coarse_solution);
+    const auto correction = current_level.prolongator.multiply(coarse_solution);
+    for (size_t row_ = 0; row_ < solution.size(); row_++) {
+        solution[row_] += correction[row_];
+    }
+    smooth(current_level, right_side, solution, false);
+}
+
+template <typename T>
+std::vector<T> algebraic_multigrid<T>::apply(const std::vector<T>& residual) const {
+    std::vector<T> result(residual.size(), static_cast<T>(0));
+    cycle(0, residual, result);
+    return result;
+}
+
+template <typename T>
+std::vector<T> algebraic_multigrid<T>::solve(const std::vector<T>& right_side, double tolerance,
+                                             size_t max_iterations) {
+    const auto& system_matrix = levels.front().system_matrix;
+    if (right_side.size() != system_matrix.get_row_number())
+        throw std::runtime_error("Linear system could not be solved: right side has wrong size");
+
+    statistics = solver_statistics();
+    std::vector<T> solution(right_side.size(), static_cast<T>(0));
+    const double right_side_norm = euclidean_norm(right_side);
+    if (right_side_norm == 0.) {
+        statistics.converged = true;
+        return solution;
+    }
+
+    statistics.relative_residual = 1.;
+    while (statistics.iterations < max_iterations) {
+        cycle(0, right_side, solution);
+        statistics.iterations++;
+        auto residual = system_matrix.multiply(solution);
+        for (size_t row_ = 0; row_ < residual.size(); row_++) {
+            residual[row_] = right_side[row_] - residual[row_];
+        }
+        statistics.relative_residual = euclidean_norm(residual) / right_side_norm;
+        if (statistics.relative_residual <= tolerance) {
+            statistics.converged = true;
+            break;
+        }
+    }
+    return solution;
+}
+
+#endif //CIRCUITS_ALGEBRAIC_MULTIGRID_H
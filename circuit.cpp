@@ -1,3 +1,5 @@
+#include <charconv>
+#include <cstring>
 #include "circuit.h"
 
 template<>
@@ -6,6 +8,22 @@ void circuit<double>::fill_parameters(double &resistance, double &emf, const inp
     emf = state.emf.real();
 }
 
+template <>
+bool circuit<double>::solve_symmetric_system(const matrix<double> &nodal_matrix,
+                                             const matrix<double> &injection_matrix,
+                                             matrix<double> &flow_matrix) const {
+    cholesky_factorization<double> factorization(nodal_matrix);
+    if (factorization.is_singular())
+        return false;
+    flow_matrix = factorization.solve(injection_matrix);
+    return true;
+}
+
+template <>
+solver_options::preconditioner_type circuit<double>::get_iterative_preconditioner() const {
+    return options.preconditioner;
+}
+
 template <>
 void circuit<double>::modify_answer_loop(std::stringstream &answer, size_t vertex_index) const {
     answer << loop_current[vertex_index] << " A";
@@ -13,5 +31,44 @@ void circuit<double>::modify_answer_loop(std::stringstream &answer, size_t verte
 
 template <>
 void circuit<double>::modify_answer_edge(std::stringstream &answer, graph::edge edge, size_t subgraph_index) {
-    answer << edge_current_matrix[subgraph_index][edge][0] << " A";
-}
\ No newline at end of file
+    answer << edge_current[subgraph_index][edge] << " A";
+}
+
+template <typename T>
+static bool parse_option_value(const char* value, T& result) {
+    const char* value_end = value + std::strlen(value);
+    auto [end, error] = std::from_chars(value, value_end, result);
+    return error == std::errc() && end == value_end;
+}
+
+option_status parse_solver_option(int& argument, int argc, char* argv[], solver_options& options) {
+    std::string option(argv[argument]);
+    if (option == "--iterative") {
+        options.solver = solver_options::method::iterative;
+    } else if (option == "--multigrid") {
+        options.solver = solver_options::method::multigrid;
+    } else if (option == "--jacobi") {
+        options.preconditioner = solver_options::preconditioner_type::jacobi;
+    } else if (option == "--amg") {
+        options.preconditioner = solver_options::preconditioner_type::algebraic_multigrid;
+    } else if (option == "--tolerance" && argument + 1 < argc) {
+        if (!parse_option_value(argv[++argument], options.tolerance))
+            return option_status::invalid;
+    } else if (option == "--max-iterations" && argument + 1 < argc) {
+        if (!parse_option_value(argv[++argument], options.max_iterations))
+            return option_status::invalid;
+    } else if (option == "--threads" && argument + 1 < argc) {
+        if (!parse_option_value(argv[++argument], options.thread_number))
+            return option_status::invalid;
+    } else {
+        return option_status::not_option;
+    }
+    return option_status::parsed;
+}
+
+void print_solver_statistics(const std::vector<solver_statistics>& statistics, std::ostream& output) {
+    for (size_t block_index = 0; block_index < statistics.size(); block_index++) {
+        output << "Block " << block_index + 1 << ": " << statistics[block_index].iterations <<
+               " iterations, relative residual " << statistics[block_index].relative_residual << std::endl;
+    }
+}
@@ -1,19 +1,31 @@
 #ifndef CIRCUITS_CIRCUIT_H
 #define CIRCUITS_CIRCUIT_H
 
+#include <numeric>
 #include <sstream>
+#include <unordered_map>
 #include "matrix.h"
+#include "sparse_matrix.h"
+#include "iterative_solver.h"
+#include "algebraic_multigrid.h"
+#include "thread_pool.h"
 #include "graph.h"
+#include "network_reduction.h"
 #include "input_parser.h"
+#include "netlist_reader.h"
 #include "input_preworker.h"
 
 template <typename T>
 class circuit {
 public:
-    circuit(const std::string& input_string);
+    circuit(std::string_view input_string, const solver_options& options_ = solver_options());
+    circuit(std::istream& input, const solver_options& options_ = solver_options());
+    circuit(const netlist_reader::edges& edges, bool is_alternating_current,
+            const solver_options& options_ = solver_options());
 
     void calculate_edge_current();
     std::string get_edge_current_answer();
+    const std::vector<solver_statistics>& get_solver_statistics() const { return block_solver_statistics; }
 
     class ZeroResistanceException : public std::exception {
         const char* what () const throw () { return "Zero resistances was replaced with 1e-9 Ohm"; }
@@ -28,24 +40,40 @@ public:
 
 private:
     bool is_ac = false;
-    std::vector<matrix<T>> conductivity_matrix;
-    std::vector<matrix<T>> emf_matrix;
-    std::vector<matrix<T>> incidence_matrix;
-    std::vector<matrix<T>> edge_current_matrix;
+    solver_options options;
+    std::vector<solver_statistics> block_solver_statistics;
+    std::vector<std::stringstream> block_messages;
+    std::vector<std::vector<T>> edge_conductivity;
+    std::vector<std::vector<T>> edge_emf;
+    std::vector<std::vector<T>> edge_current;
     graph circuit_graph;
-    std::vector<graph> circuit_subgraphs;
+    std::vector<graph::vertex> vertex_labels;
+    graph::subgraph_partition circuit_subgraphs;
+    std::vector<graph> circuit_blocks;
+    std::vector<size_t> block_subgraph;
+    std::vector<graph::edges> block_subgraph_edges;
+    std::vector<network_reduction<T>> block_reductions;
     std::vector<T> loop_resistance;
     std::vector<T> loop_emf;
     std::vector<T> loop_current;
 
-    void fill_conductivity_matrix(const std::vector<T> &edge_resistance, size_t edge_number,
-                                  size_t subgraph_index);
-    void fill_emf_matrix(const std::vector<T> &edge_voltage, size_t edge_number, size_t subgraph_index);
-    void fill_incidence_matrix(size_t vertex_number, size_t edge_number, size_t subgraph_index);
-    void fill_circuit_matrices(const std::vector<T> &edge_resistance,
-                               const std::vector<T> &edge_voltage);
+    void fill_circuit_parameters(const std::vector<T> &edge_resistance,
+                                 const std::vector<T> &edge_voltage);
 
-    std::pair<std::vector<T>, std::vector<T>> fill_circuit_graph(input_parser &parser);
+    struct parsed_branches {
+        std::vector<graph::tied_vertices> branch_vertices;
+        std::vector<T> branch_resistance;
+        std::vector<T> branch_emf;
+        std::unordered_map<graph::vertex, graph::vertex> vertex_ids;
+        bool is_zero_resistance_exist = false;
+    };
+
+    size_t get_parser_thread_number() const;
+    void add_branches(const netlist_reader::edges &edges, parsed_branches &branches);
+    void build_circuit(bool is_alternating_current, parsed_branches &branches);
+    std::pair<std::vector<T>, std::vector<T>> fill_circuit_graph(parsed_branches &branches);
+    static graph::vertex intern_vertex(graph::vertex label, std::unordered_map<graph::vertex, graph::vertex> &vertex_ids);
+    std::vector<graph::vertex> fill_vertex_labels(const std::unordered_map<graph::vertex, graph::vertex> &vertex_ids);
 
     void modify_single_edge_current_answer(std::stringstream &answer, graph::edge edge_index, size_t subgraph_index);
     void modify_answer_edge(std::stringstream &answer, graph::edge edge, size_t subgraph_index);
@@ -60,66 +88,137 @@ private:
 
     void check_vertices(graph::vertex incoming, graph::vertex outcoming) const;
 
-    std::pair<std::vector<T>, std::vector<T>>
-    fill_subgraph_edges_parameters(size_t subgraph_index, const std::vector<T> &edge_resistance,
-                                   const std::vector<T> &edge_voltage) const;
-
     void modify_subgraph_edge_current_answer(std::stringstream &answer, size_t subgraph_index);
 
-    void fill_subgraph_matrices(const std::vector<T> &edge_resistance,
-                                const std::vector<T> &edge_voltage,
-                                size_t subgraph_index);
-
     void resize_subgraph_number();
+    void resize_block_number();
+    std::vector<graph::edges> get_circuit_blocks() const;
+    void add_circuit_block(const graph::edges &block_edges, const std::vector<T> &edge_resistance,
+                           const std::vector<T> &edge_voltage);
 
     const double EPS = 1e-9;//-9
-
-    matrix<T> CalculateFlowMatrix(size_t subgraph_index);
+    static constexpr size_t Sparse_solver_min_size = 64;
+    static constexpr double Sparse_solver_max_density = 0.1;
+    static constexpr size_t Parallel_solver_min_vertex_number = 256;
+
+    std::vector<size_t> get_block_solve_order() const;
+    size_t get_solver_thread_number(const std::vector<size_t> &block_order) const;
+    void calculate_block(size_t block_index);
+    void print_block_messages();
+    matrix<T> CalculateFlowMatrix(size_t block_index);
+    matrix<T> assemble_nodal_matrix(size_t block_index) const;
+    sparse_matrix<T> assemble_sparse_nodal_matrix(size_t block_index) const;
+    bool solve_symmetric_system(const matrix<T> &nodal_matrix, const matrix<T> &injection_matrix,
+                                matrix<T> &flow_matrix) const;
+    bool solve_iterative_system(size_t block_index, matrix<T> &flow_matrix);
+    bool solve_multigrid_system(size_t block_index, matrix<T> &flow_matrix);
+    std::unique_ptr<preconditioner<T>> make_block_preconditioner(size_t block_index,
+                                                                    const sparse_matrix<T> &nodal_matrix) const;
+    std::vector<T> get_injection_vector(size_t block_index) const;
+    static matrix<T> get_flow_matrix(const std::vector<T> &flow);
+    solver_options::preconditioner_type get_iterative_preconditioner() const;
+    bool is_sparse_block(size_t block_index) const;
+    matrix<T> assemble_injection_matrix(size_t block_index) const;
+    void stamp_conductivity(matrix<T> &nodal_matrix, size_t block_index, graph::edge edge, T conductivity) const;
+    void add_resonance_resistance(matrix<T> &nodal_matrix, size_t block_index);
+    void calculate_block_edge_current(size_t block_index, const matrix<T> &flow_matrix,
+                                      std::vector<T> &current, std::vector<T> &voltage) const;
+    T get_vertex_potential(size_t block_index, const matrix<T> &flow_matrix, graph::vertex vertex) const;
 
     void fill_parameters(T &resistance, T &emf, const input_parser::state &state);
 };
 
 template <typename T>
-circuit<T>::circuit(const std::string &input_string) {
-    input_parser parser(input_string);
-    is_ac = parser.is_alternating_current();
-    auto [edge_resistance, edge_emf] = fill_circuit_graph(parser);
+circuit<T>::circuit(std::string_view input_string, const solver_options& options_):
+    options(options_)
+{
+    netlist_reader reader(get_parser_thread_number());
+    parsed_branches branches;
+    reader.read(input_string, [&](const netlist_reader::edges& edges) { add_branches(edges, branches); });
+    build_circuit(reader.is_alternating_current(), branches);
+}
+
+template <typename T>
+circuit<T>::circuit(std::istream& input, const solver_options& options_):
+    options(options_)
+{
+    netlist_reader reader(get_parser_thread_number());
+    parsed_branches branches;
+    reader.read(input, [&](const netlist_reader::edges& edges) { add_branches(edges, branches); });
+    build_circuit(reader.is_alternating_current(), branches);
+}
+
+template <typename T>
+circuit<T>::circuit(const netlist_reader::edges& edges, bool is_alternating_current, const solver_options& options_):
+    options(options_)
+{
+    parsed_branches branches;
+    add_branches(edges, branches);
+    build_circuit(is_alternating_current, branches);
+}
+
+template <typename T>
+size_t circuit<T>::get_parser_thread_number() const {
+    return options.thread_number ? options.thread_number : thread_pool::get_default_thread_number();
+}
+
+template <typename T>
+void circuit<T>::build_circuit(bool is_alternating_current, parsed_branches &branches) {
+    is_ac = is_alternating_current;
+    auto [edge_resistance, edge_emf] = fill_circuit_graph(branches);
     resize_subgraph_number();
-    fill_circuit_matrices(edge_resistance, edge_emf);
+    fill_circuit_parameters(edge_resistance, edge_emf);
+    resize_block_number();
 }
 
 template <typename T>
 void circuit<T>::resize_subgraph_number() {
-    conductivity_matrix.resize(circuit_subgraphs.size());
-    emf_matrix.resize(circuit_subgraphs.size());
-    incidence_matrix.resize(circuit_subgraphs.size());
-    edge_current_matrix.resize(circuit_subgraphs.size());
+    edge_current.resize(circuit_subgraphs.size());
+    for (size_t subgraph_index = 0; subgraph_index < circuit_subgraphs.size(); subgraph_index++) {
+        edge_current[subgraph_index].resize(circuit_subgraphs.get_edge_number(subgraph_index));
+    }
 }
 
 template <typename T>
-std::pair<std::vector<T>, std::vector<T>>
-circuit<T>::fill_circuit_graph(input_parser &parser) {
-    std::vector<T> edge_resistance, edge_emf;
-    bool is_zero_resistance_exist = false;
-    while (!parser.is_eof()) {
-        parser.make_iteration();
-        graph::vertex incoming, outcoming;
+void circuit<T>::resize_block_number() {
+    block_solver_statistics.resize(circuit_blocks.size());
+    block_messages.resize(circuit_blocks.size());
+}
+
+template <typename T>
+void circuit<T>::add_branches(const netlist_reader::edges &edges, parsed_branches &branches) {
+    for (const auto& state : edges) {
         T resistance, emf;
-        auto state = parser.get_current_edge_info();
-        incoming = state.incoming_vertex;
-        outcoming = state.outcoming_vertex;
         fill_parameters(resistance, emf, state);
-        check_vertices(incoming, outcoming);
-        is_zero_resistance_exist |= check_resistance(resistance);
-        if (circuit_graph.add_edge(outcoming - 1, incoming - 1)) {
-            edge_emf.emplace_back(parser.is_emf_included() ? emf : 0.);
-            edge_resistance.emplace_back(resistance);
+        check_vertices(state.incoming_vertex, state.outcoming_vertex);
+        branches.is_zero_resistance_exist |= check_resistance(resistance);
+        branches.branch_vertices.emplace_back(intern_vertex(state.outcoming_vertex, branches.vertex_ids),
+                                              intern_vertex(state.incoming_vertex, branches.vertex_ids));
+        branches.branch_resistance.emplace_back(resistance);
+        branches.branch_emf.emplace_back(emf);
+    }
+}
+
+template <typename T>
+std::pair<std::vector<T>, std::vector<T>>
+circuit<T>::fill_circuit_graph(parsed_branches &branches) {
+    const auto vertex_ranks = fill_vertex_labels(branches.vertex_ids);
+    branches.vertex_ids = {};
+    std::vector<T> edge_resistance, edge_emf;
+    for (size_t branch = 0; branch < branches.branch_vertices.size(); branch++) {
+        auto [outcoming, incoming] = branches.branch_vertices[branch];
+        if (circuit_graph.add_edge(vertex_ranks[outcoming], vertex_ranks[incoming])) {
+            edge_emf.emplace_back(branches.branch_emf[branch]);
+            edge_resistance.emplace_back(branches.branch_resistance[branch]);
         } else {
-            loop_resistance.emplace_back(resistance);
-            loop_emf.emplace_back(parser.is_emf_included() ? emf : 0.);
+            loop_resistance.emplace_back(branches.branch_resistance[branch]);
+            loop_emf.emplace_back(branches.branch_emf[branch]);
         }
     }
+    const bool is_zero_resistance_exist = branches.is_zero_resistance_exist;
+    branches = parsed_branches();
     check_empty_input(edge_resistance);
+    circuit_graph.build_adjacency();
     circuit_subgraphs = circuit_graph.get_coherent_subgraphs();
     if (is_zero_resistance_exist) {
         std::cout << "Zero resistances were replaced with " << EPS << " Ohm" << std::endl;
@@ -128,6 +227,30 @@ circuit<T>::fill_circuit_graph(input_parser &parser) {
     return {edge_resistance, edge_emf};
 }
 
+template <typename T>
+graph::vertex circuit<T>::intern_vertex(graph::vertex label,
+                                        std::unordered_map<graph::vertex, graph::vertex> &vertex_ids) {
+    return vertex_ids.emplace(label, vertex_ids.size()).first->second;
+}
+
+template <typename T>
+std::vector<graph::vertex>
+circuit<T>::fill_vertex_labels(const std::unordered_map<graph::vertex, graph::vertex> &vertex_ids) {
+    vertex_labels.resize(vertex_ids.size());
+    for (const auto& [label, vertex_id] : vertex_ids) {
+        vertex_labels[vertex_id] = label;
+    }
+    std::vector<graph::vertex> sorted_labels(vertex_labels);
+    std::sort(sorted_labels.begin(), sorted_labels.end());
+    std::vector<graph::vertex> vertex_ranks(vertex_labels.size());
+    for (graph::vertex vertex_id = 0; vertex_id < vertex_labels.size(); vertex_id++) {
+        vertex_ranks[vertex_id] = std::lower_bound(sorted_labels.begin(), sorted_labels.end(), vertex_labels[vertex_id]) -
+                                  sorted_labels.begin();
+    }
+    vertex_labels = std::move(sorted_labels);
+    return vertex_ranks;
+}
+
 template<typename T>
 void circuit<T>::fill_parameters(T &resistance, T &emf, const input_parser::state &state) {
     resistance = state.resistance;
@@ -159,105 +282,321 @@ bool circuit<T>::check_resistance(T& resistance) const {
 }
 
 template <typename T>
-void circuit<T>::fill_circuit_matrices(const std::vector<T> &edge_resistance,
-                                    const std::vector<T> &edge_voltage) {
-    for (size_t subgraph_index = 0; subgraph_index < circuit_subgraphs.size(); subgraph_index++) {
-        fill_subgraph_matrices(edge_resistance, edge_voltage, subgraph_index);
+void circuit<T>::fill_circuit_parameters(const std::vector<T> &edge_resistance,
+                                         const std::vector<T> &edge_voltage) {
+    for (const auto& block_edges : get_circuit_blocks()) {
+        add_circuit_block(block_edges, edge_resistance, edge_voltage);
     }
 }
 
 template <typename T>
-void circuit<T>::fill_subgraph_matrices(const std::vector<T> &edge_resistance,
-                                const std::vector<T> &edge_voltage,
-                                size_t subgraph_index) {
-    size_t vertex_number = circuit_subgraphs[subgraph_index].get_vertex_number();
-    size_t edge_number = circuit_subgraphs[subgraph_index].get_edge_number();
-    auto [subgraph_edge_resistance, subgraph_edge_voltage] =
-    fill_subgraph_edges_parameters(subgraph_index, edge_resistance, edge_voltage);
+std::vector<graph::edges> circuit<T>::get_circuit_blocks() const {
+    auto blocks = circuit_graph.get_biconnected_components();
+    auto is_subgraph_ordered = [this](graph::edge first, graph::edge second) {
+        return circuit_subgraphs.get_edge_position(first) < circuit_subgraphs.get_edge_position(second);
+    };
+    for (auto& block_edges : blocks) {
+        std::sort(block_edges.begin(), block_edges.end(), is_subgraph_ordered);
+    }
+    std::sort(blocks.begin(), blocks.end(), [&is_subgraph_ordered](const graph::edges& first, const graph::edges& second) {
+        return is_subgraph_ordered(first.front(), second.front());
+    });
+    return blocks;
+}
+
+template <typename T>
+void circuit<T>::add_circuit_block(const graph::edges &block_edges, const std::vector<T> &edge_resistance,
+                                   const std::vector<T> &edge_voltage) {
+    std::vector<T> block_conductivity(block_edges.size()), block_emf(block_edges.size());
+    graph::edges subgraph_edges(block_edges.size());
+    for (graph::edge edge = 0; edge < block_edges.size(); edge++) {
+        block_conductivity[edge] = T(1) / edge_resistance[block_edges[edge]];
+        block_emf[edge] = edge_voltage[block_edges[edge]];
+        subgraph_edges[edge] = circuit_subgraphs.get_subgraph_edge(block_edges[edge]);
+    }
+    network_reduction<T> reduction(circuit_graph.get_edges_subgraph(block_edges), block_conductivity, block_emf);
+    circuit_blocks.push_back(reduction.get_reduced_graph());
+    circuit_blocks.back().build_adjacency();
+    edge_conductivity.push_back(reduction.get_reduced_conductivity());
+    edge_emf.push_back(reduction.get_reduced_emf());
+    block_subgraph.push_back(circuit_subgraphs.get_edge_subgraph(block_edges.front()));
+    block_subgraph_edges.push_back(std::move(subgraph_edges));
+    block_reductions.push_back(std::move(reduction));
+}
 
-    if (!edge_number)
-        return;
+template <typename T>
+void circuit<T>::calculate_edge_current() {
+    const auto block_order = get_block_solve_order();
+    const size_t thread_number = get_solver_thread_number(block_order);
+    if (thread_number > 1) {
+        thread_pool pool(thread_number);
+        std::vector<std::future<void>> block_results;
+        block_results.reserve(block_order.size());
+        for (size_t block_index : block_order) {
+            block_results.push_back(pool.submit([this, block_index] { calculate_block(block_index); }));
+        }
+        for (auto& block_result : block_results) {
+            block_result.get();
+        }
+    } else {
+        for (size_t block_index : block_order) {
+            calculate_block(block_index);
+        }
+    }
+    print_block_messages();
+    calculate_loop_current();
+}
 
-    fill_conductivity_matrix(subgraph_edge_resistance, edge_number, subgraph_index);
-    fill_emf_matrix(subgraph_edge_voltage, edge_number, subgraph_index);
-    fill_incidence_matrix(vertex_number, edge_number, subgraph_index);
+template <typename T>
+std::vector<size_t> circuit<T>::get_block_solve_order() const {
+    std::vector<size_t> block_order(circuit_blocks.size());
+    std::iota(block_order.begin(), block_order.end(), 0);
+    std::stable_sort(block_order.begin(), block_order.end(), [this](size_t first, size_t second) {
+        return circuit_blocks[first].get_vertex_number() > circuit_blocks[second].get_vertex_number();
+    });
+    return block_order;
 }
 
 template <typename T>
-std::pair<std::vector<T>, std::vector<T>>
-circuit<T>::fill_subgraph_edges_parameters(size_t subgraph_index, const std::vector<T>& edge_resistance,
-                                        const std::vector<T>& edge_voltage) const {
-    std::vector<T> subgraph_edge_resistance(circuit_subgraphs[subgraph_index].get_edge_number()),
-            subgraph_edge_voltage(circuit_subgraphs[subgraph_index].get_edge_number());
-
-    for (size_t edge_index = 0; edge_index < circuit_subgraphs[subgraph_index].get_edge_number(); edge_index++) {
-        graph::edge circuit_graph_edge = circuit_graph.get_subgraph_mapping_edge({subgraph_index, edge_index});
-        subgraph_edge_resistance[edge_index] = edge_resistance[circuit_graph_edge];
-        subgraph_edge_voltage[edge_index] = edge_voltage[circuit_graph_edge];
+size_t circuit<T>::get_solver_thread_number(const std::vector<size_t> &block_order) const {
+    size_t vertex_number = 0;
+    for (size_t block_index : block_order) {
+        vertex_number += circuit_blocks[block_index].get_vertex_number();
     }
+    if (block_order.size() < 2 || vertex_number < Parallel_solver_min_vertex_number)
+        return 1;
+    const size_t thread_number = options.thread_number ? options.thread_number : thread_pool::get_default_thread_number();
+    return std::min(thread_number, block_order.size());
+}
 
-    return {subgraph_edge_resistance, subgraph_edge_voltage};
+template <typename T>
+void circuit<T>::calculate_block(size_t block_index) {
+    const size_t edge_number = circuit_blocks[block_index].get_edge_number();
+    std::vector<T> current(edge_number), voltage(edge_number);
+    if (edge_number)
+        calculate_block_edge_current(block_index, CalculateFlowMatrix(block_index), current, voltage);
+    else
+        block_solver_statistics[block_index].converged = true;
+    auto block_edge_current = block_reductions[block_index].get_edge_current(current, voltage);
+    auto& subgraph_edge_current = edge_current[block_subgraph[block_index]];
+    for (graph::edge edge = 0; edge < block_edge_current.size(); edge++) {
+        subgraph_edge_current[block_subgraph_edges[block_index][edge]] = block_edge_current[edge];
+    }
 }
 
 template <typename T>
-void circuit<T>::fill_incidence_matrix(size_t vertex_number, size_t edge_number, size_t subgraph_index) {
-    incidence_matrix[subgraph_index] = matrix<T>(vertex_number - 1, edge_number);
-    for (graph::vertex vertex = 0; vertex < vertex_number - 1; vertex++) {
-        auto current_incoming_edges = circuit_subgraphs[subgraph_index].get_incoming_edges(vertex);
-        for (auto edge : current_incoming_edges) {
-            incidence_matrix[subgraph_index][vertex][edge] = 1.;
-        }
-        auto current_outcoming_edges = circuit_subgraphs[subgraph_index].get_outcoming_edges(vertex);
-        for (auto edge : current_outcoming_edges) {
-            incidence_matrix[subgraph_index][vertex][edge] = -1.;
-        }
+void circuit<T>::print_block_messages() {
+    for (auto& messages : block_messages) {
+        std::cout << messages.str();
+        messages.str(std::string());
     }
 }
 
 template <typename T>
-void circuit<T>::fill_emf_matrix(const std::vector<T> &edge_voltage, size_t edge_number,
-                              size_t subgraph_index) {
-    emf_matrix[subgraph_index] = matrix<T>(edge_number, 1);
-    for (graph::edge edge = 0; edge < edge_voltage.size(); edge++) {
-        emf_matrix[subgraph_index][edge][0] = edge_voltage[edge];
+matrix<T> circuit<T>::CalculateFlowMatrix(size_t block_index) {
+    matrix<T> flow_matrix;
+    if (options.solver == solver_options::method::iterative && solve_iterative_system(block_index, flow_matrix))
+        return flow_matrix;
+    if (options.solver == solver_options::method::multigrid && solve_multigrid_system(block_index, flow_matrix))
+        return flow_matrix;
+    if (is_sparse_block(block_index)) {
+        auto sparse_factorization = assemble_sparse_nodal_matrix(block_index).factorize();
+        if (!sparse_factorization.is_singular())
+            return sparse_factorization.solve(assemble_injection_matrix(block_index));
+    }
+    auto nodal_matrix = assemble_nodal_matrix(block_index);
+    auto injection_matrix = assemble_injection_matrix(block_index);
+    if (solve_symmetric_system(nodal_matrix, injection_matrix, flow_matrix))
+        return flow_matrix;
+    auto factorization = nodal_matrix.factorize();
+    if (factorization.is_singular()) {
+        block_messages[block_index] << "Resonant circuit was updated via adding " << EPS << " Ohm resistance\n";
+        add_resonance_resistance(nodal_matrix, block_index);
+        factorization = nodal_matrix.factorize();
     }
+    return factorization.solve(injection_matrix);
+}
+
+template <typename T>
+bool circuit<T>::solve_symmetric_system(const matrix<T> &nodal_matrix, const matrix<T> &injection_matrix,
+                                        matrix<T> &flow_matrix) const {
+    ldl_factorization<T> factorization(nodal_matrix);
+    if (factorization.is_singular())
+        return false;
+    flow_matrix = factorization.solve(injection_matrix);
+    return true;
 }
 
+template <>
+bool circuit<double>::solve_symmetric_system(const matrix<double> &nodal_matrix,
+                                             const matrix<double> &injection_matrix,
+                                             matrix<double> &flow_matrix) const;
+
 template <typename T>
-void circuit<T>::fill_conductivity_matrix(const std::vector<T> &edge_resistance, size_t edge_number,
-                                       size_t subgraph_index) {
-    conductivity_matrix[subgraph_index] = matrix<T>(edge_number, edge_number);
-    for (graph::edge edge = 0; edge < edge_resistance.size(); edge++) {
-        conductivity_matrix[subgraph_index][edge][edge] = T(1) / edge_resistance[edge];
+bool circuit<T>::solve_iterative_system(size_t block_index, matrix<T> &flow_matrix) {
+    auto nodal_matrix = assemble_sparse_nodal_matrix(block_index);
+    auto system_preconditioner = make_block_preconditioner(block_index, nodal_matrix);
+    auto injection = get_injection_vector(block_index);
+
+    auto& statistics = block_solver_statistics[block_index];
+    conjugate_gradient<T> solver(nodal_matrix, *system_preconditioner, options.tolerance, options.max_iterations);
+    auto flow = solver.solve(injection);
+    statistics = solver.get_statistics();
+    if (!statistics.converged) {
+        block_messages[block_index] << "Conjugate gradient did not converge in " << statistics.iterations <<
+                  " iterations, BiCGSTAB is used\n";
+        biconjugate_gradient_stabilized<T> fallback_solver(nodal_matrix, *system_preconditioner,
+                                                           options.tolerance, options.max_iterations);
+        flow = fallback_solver.solve(injection);
+        const size_t iterations = statistics.iterations;
+        statistics = fallback_solver.get_statistics();
+        statistics.iterations += iterations;
+    }
+    if (!statistics.converged) {
+        block_messages[block_index] << "BiCGSTAB did not converge, direct solver is used\n";
+        return false;
     }
+    flow_matrix = get_flow_matrix(flow);
+    return true;
 }
 
 template <typename T>
-void circuit<T>::calculate_edge_current() {
-    for (size_t subgraph_index = 0; subgraph_index < circuit_subgraphs.size(); subgraph_index++) {
-        auto flow_matrix = CalculateFlowMatrix(subgraph_index);
-        auto voltage_matrix = incidence_matrix[subgraph_index].transpose() * flow_matrix;
-        edge_current_matrix[subgraph_index] = conductivity_matrix[subgraph_index] *
-                                              (emf_matrix[subgraph_index] - voltage_matrix);
+bool circuit<T>::solve_multigrid_system(size_t block_index, matrix<T> &flow_matrix) {
+    const auto& block = circuit_blocks[block_index];
+    algebraic_multigrid<T> solver(block, edge_conductivity[block_index], block.get_vertex_number() - 1);
+    auto flow = solver.solve(get_injection_vector(block_index), options.tolerance, options.max_iterations);
+    block_solver_statistics[block_index] = solver.get_statistics();
+    if (!solver.get_statistics().converged) {
+        block_messages[block_index] << "Multigrid did not converge in " << solver.get_statistics().iterations <<
+                  " cycles, direct solver is used\n";
+        return false;
     }
-    calculate_loop_current();
+    flow_matrix = get_flow_matrix(flow);
+    return true;
+}
+
+template <typename T>
+std::unique_ptr<preconditioner<T>> circuit<T>::make_block_preconditioner(size_t block_index,
+                                                                            const sparse_matrix<T> &nodal_matrix) const {
+    const auto type = get_iterative_preconditioner();
+    if (type != solver_options::preconditioner_type::algebraic_multigrid)
+        return make_preconditioner(nodal_matrix, type);
+    const auto& block = circuit_blocks[block_index];
+    return std::make_unique<algebraic_multigrid<T>>(block, edge_conductivity[block_index],
+                                                    block.get_vertex_number() - 1);
+}
+
+template <typename T>
+std::vector<T> circuit<T>::get_injection_vector(size_t block_index) const {
+    auto injection_matrix = assemble_injection_matrix(block_index);
+    std::vector<T> injection(injection_matrix.get_row_number());
+    for (size_t row = 0; row < injection.size(); row++) {
+        injection[row] = injection_matrix[row][0];
+    }
+    return injection;
 }
 
 template <typename T>
-matrix<T> circuit<T>::CalculateFlowMatrix(size_t subgraph_index) {
-    auto flow_matrix = incidence_matrix[subgraph_index] * conductivity_matrix[subgraph_index] *
-                       incidence_matrix[subgraph_index].transpose();
-    try {
-        flow_matrix = flow_matrix.inverse() * incidence_matrix[subgraph_index] * conductivity_matrix[subgraph_index] *
-                      emf_matrix[subgraph_index];
-    } catch (typename matrix<T>::ZeroDivisionException&) {
-        std::cout << "Resonant circuit was updated via adding " << EPS << " Ohm resistance\n";
-        conductivity_matrix[subgraph_index][0][0] = 1. / (1. / conductivity_matrix[subgraph_index][0][0] + EPS);
-        return CalculateFlowMatrix(subgraph_index);
+matrix<T> circuit<T>::get_flow_matrix(const std::vector<T> &flow) {
+    matrix<T> flow_matrix(flow.size(), 1);
+    for (size_t row = 0; row < flow.size(); row++) {
+        flow_matrix[row][0] = flow[row];
     }
     return flow_matrix;
 }
 
+template <typename T>
+solver_options::preconditioner_type circuit<T>::get_iterative_preconditioner() const {
+    if (options.preconditioner == solver_options::preconditioner_type::incomplete_cholesky)
+        return solver_options::preconditioner_type::incomplete_lu;
+    return options.preconditioner;
+}
+
+template <>
+solver_options::preconditioner_type circuit<double>::get_iterative_preconditioner() const;
+
+template <typename T>
+matrix<T> circuit<T>::assemble_nodal_matrix(size_t block_index) const {
+    const auto& block = circuit_blocks[block_index];
+    matrix<T> nodal_matrix(block.get_vertex_number() - 1, block.get_vertex_number() - 1);
+    for (graph::edge edge = 0; edge < block.get_edge_number(); edge++) {
+        stamp_conductivity(nodal_matrix, block_index, edge, edge_conductivity[block_index][edge]);
+    }
+    return nodal_matrix;
+}
+
+template <typename T>
+sparse_matrix<T> circuit<T>::assemble_sparse_nodal_matrix(size_t block_index) const {
+    const auto& block = circuit_blocks[block_index];
+    return sparse_matrix<T>::laplacian(block, edge_conductivity[block_index], block.get_vertex_number() - 1);
+}
+
+template <typename T>
+bool circuit<T>::is_sparse_block(size_t block_index) const {
+    const auto& block = circuit_blocks[block_index];
+    const double size = block.get_vertex_number() - 1;
+    const double nonzero_estimate = size + 2. * block.get_edge_number();
+    return size >= Sparse_solver_min_size && nonzero_estimate <= Sparse_solver_max_density * size * size;
+}
+
+template <typename T>
+void circuit<T>::stamp_conductivity(matrix<T> &nodal_matrix, size_t block_index, graph::edge edge,
+                                    T conductivity) const {
+    auto [outcoming, incoming] = circuit_blocks[block_index].get_tied_vertices(edge);
+    const graph::vertex ground = nodal_matrix.get_row_number();
+    if (outcoming != ground)
+        nodal_matrix[outcoming][outcoming] += conductivity;
+    if (incoming != ground)
+        nodal_matrix[incoming][incoming] += conductivity;
+    if (outcoming != ground && incoming != ground) {
+        nodal_matrix[outcoming][incoming] -= conductivity;
+        nodal_matrix[incoming][outcoming] -= conductivity;
+    }
+}
+
+template <typename T>
+matrix<T> circuit<T>::assemble_injection_matrix(size_t block_index) const {
+    const auto& block = circuit_blocks[block_index];
+    const graph::vertex ground = block.get_vertex_number() - 1;
+    matrix<T> injection_matrix(ground, 1);
+    for (graph::edge edge = 0; edge < block.get_edge_number(); edge++) {
+        auto [outcoming, incoming] = block.get_tied_vertices(edge);
+        const T edge_injection = edge_conductivity[block_index][edge] * edge_emf[block_index][edge];
+        if (outcoming != ground)
+            injection_matrix[outcoming][0] -= edge_injection;
+        if (incoming != ground)
+            injection_matrix[incoming][0] += edge_injection;
+    }
+    return injection_matrix;
+}
+
+template <typename T>
+void circuit<T>::add_resonance_resistance(matrix<T> &nodal_matrix, size_t block_index) {
+    auto& conductivity = edge_conductivity[block_index][0];
+    const T previous_conductivity = conductivity;
+    conductivity = 1. / (1. / conductivity + EPS);
+    stamp_conductivity(nodal_matrix, block_index, 0, conductivity - previous_conductivity);
+}
+
+template <typename T>
+void circuit<T>::calculate_block_edge_current(size_t block_index, const matrix<T> &flow_matrix,
+                                              std::vector<T> &current, std::vector<T> &voltage) const {
+    const auto& block = circuit_blocks[block_index];
+    for (graph::edge edge = 0; edge < block.get_edge_number(); edge++) {
+        auto [outcoming, incoming] = block.get_tied_vertices(edge);
+        voltage[edge] = get_vertex_potential(block_index, flow_matrix, incoming) -
+                        get_vertex_potential(block_index, flow_matrix, outcoming);
+        current[edge] = edge_conductivity[block_index][edge] * (edge_emf[block_index][edge] - voltage[edge]);
+    }
+}
+
+template <typename T>
+T circuit<T>::get_vertex_potential(size_t block_index, const matrix<T> &flow_matrix, graph::vertex vertex) const {
+    if (vertex == circuit_blocks[block_index].get_vertex_number() - 1)
+        return static_cast<T>(0);
+    return flow_matrix[vertex][0];
+}
+
 template <typename T>
 void circuit<T>::calculate_loop_current() {
     for (size_t loop_index = 0; loop_index < loop_resistance.size(); loop_index++) {
@@ -279,9 +618,7 @@ std::string circuit<T>::get_edge_current_answer() {
 
 template <typename T>
 void circuit<T>::modify_subgraph_edge_current_answer(std::stringstream &answer, size_t subgraph_index) {
-    if (!conductivity_matrix[subgraph_index].get_row_number())
-        return;
-    for (graph::edge edge_index = 0; edge_index < edge_current_matrix[subgraph_index].get_row_number(); edge_index++) {
+    for (graph::edge edge_index = 0; edge_index < edge_current[subgraph_index].size(); edge_index++) {
         modify_single_edge_current_answer(answer, edge_index, subgraph_index);
         answer << '\n';
     }
@@ -291,7 +628,7 @@ template <typename T>
 void circuit<T>::modify_loops_current_answer(std::stringstream &answer) const {
     auto& loops = circuit_graph.get_loops();
     for (size_t vertex_index = 0; vertex_index < loops.size(); vertex_index++) {
-        answer << loops[vertex_index] + 1 << " -- " << loops[vertex_index] + 1 << ": ";
+        answer << vertex_labels[loops[vertex_index]] << " -- " << vertex_labels[loops[vertex_index]] << ": ";
         modify_answer_loop(answer, vertex_index);
         answer << ";\n";
     }
@@ -309,41 +646,57 @@ void circuit<double>::modify_answer_loop(std::stringstream &answer, size_t verte
 template <typename T>
 void circuit<T>::modify_single_edge_current_answer(std::stringstream &answer, graph::edge edge, size_t subgraph_index) {
     auto [incoming_vertex, outcoming_vertex] =
-    circuit_graph.get_tied_vertices(circuit_graph.get_subgraph_mapping_edge({subgraph_index, edge}));
-    answer << incoming_vertex + 1 << " -- " << outcoming_vertex + 1 << ": ";
+    circuit_graph.get_tied_vertices(circuit_subgraphs.get_edge(subgraph_index, edge));
+    answer << vertex_labels[incoming_vertex] << " -- " << vertex_labels[outcoming_vertex] << ": ";
     modify_answer_edge(answer, edge, subgraph_index);
     answer << ';';
 }
 
 template <typename T>
 void circuit<T>::modify_answer_edge(std::stringstream &answer, graph::edge edge, size_t subgraph_index) {
-    answer << std::abs(edge_current_matrix[subgraph_index][edge][0]) << " A, " <<
-           std::arg(edge_current_matrix[subgraph_index][edge][0]) / M_PI * 180;
+    answer << std::abs(edge_current[subgraph_index][edge]) << " A, " <<
+           std::arg(edge_current[subgraph_index][edge]) / M_PI * 180;
 }
 
 template <>
 void circuit<double>::modify_answer_edge(std::stringstream &answer, graph::edge edge, size_t subgraph_index);
 
+enum class option_status { parsed, not_option, invalid };
+
+// Reads the option at argv[argument] with its value, the argument is moved to the last parsed one
+option_status parse_solver_option(int& argument, int argc, char* argv[], solver_options& options);
+void print_solver_statistics(const std::vector<solver_statistics>& statistics, std::ostream& output = std::cerr);
+
 template <typename T>
-void calculate_circuit(std::istream& input = std::cin, std::ostream& output = std::cout) {
-    std::string inp;
-    std::string input_string;
-    while (std::getline(input, inp)) {
-        inp.push_back(' ');
-        input_string.insert(input_string.length(), inp);
-    }
-    circuit<T> cir(input_string);
+std::vector<solver_statistics> calculate_circuit(std::string_view input, std::ostream& output = std::cout,
+                                                 const solver_options& options = solver_options()) {
+    circuit<T> cir(input, options);
+    cir.calculate_edge_current();
+    output << cir.get_edge_current_answer();
+    return cir.get_solver_statistics();
+}
+
+template <typename T>
+std::vector<solver_statistics> calculate_circuit(std::istream& input = std::cin, std::ostream& output = std::cout,
+                                                 const solver_options& options = solver_options()) {
+    circuit<T> cir(input, options);
     cir.calculate_edge_current();
     output << cir.get_edge_current_answer();
+    return cir.get_solver_statistics();
 }
 
 template <typename T>
-void calculate_complex_circuit(std::istream& input = std::cin, const std::string& file_name = "input", std::ostream& output = std::cout) {
-    input_preworker preworker(input, file_name, 0);
+std::vector<solver_statistics> calculate_complex_circuit(std::istream& input = std::cin, const std::string& file_name = "input",
+                                                         std::ostream& output = std::cout,
+                                                         const solver_options& options = solver_options()) {
+    const size_t thread_number = options.thread_number ? options.thread_number : thread_pool::get_default_thread_number();
+    input_preworker preworker(input, file_name, 0, false, thread_number);
     preworker.perform_prework();
-    circuit<T> cir(preworker.get_output());
+    // Edges of complex circuits always have reactances
+    circuit<T> cir(preworker.get_edges(), true, options);
     cir.calculate_edge_current();
     output << cir.get_edge_current_answer();
+    return cir.get_solver_statistics();
 }
 
 #endif //CIRCUITS_CIRCUIT_H
@@ -1,6 +1,34 @@
 #include "circuit.h"
 
-int main() {
-    calculate_circuit<double>();
+int main(int argc, char* argv[]) {
+    solver_options options;
+    std::vector<std::string> file_names;
+    for (int argument = 1; argument < argc; argument++) {
+        const auto status = parse_solver_option(argument, argc, argv, options);
+        if (status == option_status::invalid) {
+            std::cout << "Invalid argument: " << argv[argument - 1] << " " << argv[argument] << std::endl;
+            return 1;
+        }
+        if (status == option_status::not_option)
+            file_names.emplace_back(argv[argument]);
+    }
+    if (file_names.size() > 1) {
+        std::cout << "Invalid number of arguments: only input file required" << std::endl;
+        return 1;
+    }
+    std::vector<solver_statistics> statistics;
+    if (file_names.size() == 1) {
+        try {
+            mapped_input input_file(file_names[0]);
+            statistics = calculate_circuit<double>(input_file.get_view(), std::cout, options);
+        } catch (const mapped_input::FileOpenException&) {
+            std::cout << "File " << file_names[0] << " failed to open" << std::endl;
+            return 2;
+        }
+    } else {
+        statistics = calculate_circuit<double>(std::cin, std::cout, options);
+    }
+    if (options.solver != solver_options::method::direct)
+        print_solver_statistics(statistics);
     return 0;
 }
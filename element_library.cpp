@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <unordered_map>
+#include "element_library.h"
+
+element_library::element_library(const std::string &file_name): file(file_name) {
+    if (file.get_view().size() < sizeof(header))
+        throw InvalidLibraryException();
+    header_ = reinterpret_cast<const header*>(file.get_view().data());
+    if (!std::equal(Magic, Magic + sizeof(Magic), header_->magic) || header_->version != Version)
+        throw InvalidLibraryException();
+    string_offsets = get_section<uint64_t>(header_->string_offsets_offset, header_->string_number + 1);
+    string_data = get_section<char>(header_->string_data_offset, header_->string_data_size);
+    elements = get_section<library_element>(header_->elements_offset, header_->element_number);
+    slots = get_section<uint32_t>(header_->slots_offset, header_->slot_number);
+    edges = get_section<library_edge>(header_->edges_offset, header_->edge_number);
+    attributes = get_section<uint32_t>(header_->attributes_offset, header_->attribute_number);
+}
+
+template <typename T>
+const T* element_library::get_section(uint64_t offset, uint64_t number) const {
+    const auto data = file.get_view();
+    if (offset % alignof(T) || offset > data.size() || number > (data.size() - offset) / sizeof(T))
+        throw InvalidLibraryException();
+    return reinterpret_cast<const T*>(data.data() + offset);
+}
+
+std::string_view element_library::get_string(uint32_t string_index) const {
+    if (string_index >= header_->string_number)
+        throw InvalidLibraryException();
+    const uint64_t begin = string_offsets[string_index];
+    const uint64_t end = string_offsets[string_index + 1];
+    if (begin > end || end > header_->string_data_size)
+        throw InvalidLibraryException();
+    return std::string_view(string_data + begin, end - begin);
+}
+
+const element_library::library_element* element_library::find(std::string_view name) const {
+    const auto elements_end = elements + header_->element_number;
+    auto element_it = std::lower_bound(elements, elements_end, name,
+                                       [this](const library_element &element_, std::string_view element_name) {
+        return get_string(element_.name) < element_name;
+    });
+    if (element_it == elements_end || get_string(element_it->name) != name)
+        return nullptr;
+    return element_it;
+}
+
+bool element_library::find_element(std::string_view name, input_preworker::element &element_) const {
+    const library_element *record = find(name);
+    if (!record)
+        return false;
+    const uint64_t slot_number = uint64_t(record->parameter_number) + record->internal_number;
+    if (record->first_slot > header_->slot_number || slot_number > header_->slot_number - record->first_slot ||
+        record->first_edge > header_->edge_number || record->edge_number > header_->edge_number - record->first_edge)
+        throw InvalidLibraryException();
+
+    element_ = input_preworker::element();
+    element_.name = name;
+    std::vector<std::string> slot_names;
+    for (uint64_t slot = 0; slot < slot_number; slot++) {
+        slot_names.emplace_back(get_string(slots[record->first_slot + slot]));
+        if (slot < record->parameter_number)
+            element_.parameters.push_back(slot_names.back());
+        else
+            element_.internal_variables.push_back(slot_names.back());
+        element_.variables.insert(slot_names.back());
+    }
+    for (uint64_t edge_index = 0; edge_index < record->edge_number; edge_index++) {
+        const auto &edge = edges[record->first_edge + edge_index];
+        if (edge.outcoming_slot >= slot_number || edge.incoming_slot >= slot_number ||
+            edge.first_attribute > header_->attribute_number ||
+            edge.attribute_number > header_->attribute_number - edge.first_attribute)
+            throw InvalidLibraryException();
+        std::vector<std::string> token_line{"", slot_names[edge.outcoming_slot], slot_names[edge.incoming_slot]};
+        for (uint32_t attribute = 0; attribute < edge.attribute_number; attribute++) {
+            token_line.emplace_back(get_string(attributes[edge.first_attribute + attribute]));
+        }
+        element_.edges.push_back(std::move(token_line));
+        element_.compiled_edges.push_back({edge.outcoming_slot, edge.incoming_slot,
+                                           std::complex<double>(edge.resistance[0], edge.resistance[1]),
+                                           std::complex<double>(edge.emf[0], edge.emf[1])});
+    }
+    return true;
+}
+
+std::vector<std::string> element_library::get_element_names() const {
+    std::vector<std::string> names;
+    for (uint32_t element_index = 0; element_index < header_->element_number; element_index++) {
+        names.emplace_back(get_string(elements[element_index].name));
+    }
+    return names;
+}
+
+bool element_library::is_library(std::istream &input) {
+    char magic[sizeof(Magic)];
+    input.read(magic, sizeof(magic));
+    const bool is_library_ = input.gcount() == sizeof(magic) && std::equal(Magic, Magic + sizeof(Magic), magic);
+    input.clear();
+    input.seekg(0);
+    return is_library_;
+}
+
+void element_library::write(const std::vector<const input_preworker::element*> &elements, std::ostream &output) {
+    std::vector<const input_preworker::element*> sorted_elements(elements);
+    std::sort(sorted_elements.begin(), sorted_elements.end(), [](auto first, auto second) {
+        return first->name < second->name;
+    });
+
+    std::vector<uint64_t> string_offsets{0};
+    std::string string_data;
+    std::unordered_map<std::string, uint32_t> string_ids;
+    auto intern = [&](const std::string &string) {
+        auto [string_it, is_new_string] = string_ids.emplace(string, string_ids.size());
+        if (is_new_string) {
+            string_data += string;
+            string_offsets.push_back(string_data.size());
+        }
+        return string_it->second;
+    };
+    std::vector<library_element> element_records;
+    std::vector<uint32_t> slot_names;
+    std::vector<library_edge> edge_records;
+    std::vector<uint32_t> attribute_ids;
+    for (const auto element_ : sorted_elements) {
+        element_records.push_back({intern(element_->name), uint32_t(element_->parameters.size()),
+                                   uint32_t(element_->internal_variables.size()),
+                                   uint32_t(element_->compiled_edges.size()), slot_names.size(), edge_records.size()});
+        for (const auto &parameter : element_->parameters) {
+            slot_names.push_back(intern(parameter));
+        }
+        for (const auto &internal_variable : element_->internal_variables) {
+            slot_names.push_back(intern(internal_variable));
+        }
+        for (size_t edge_index = 0; edge_index < element_->compiled_edges.size(); edge_index++) {
+            const auto &edge = element_->compiled_edges[edge_index];
+            const auto &token_line = element_->edges[edge_index];
+            edge_records.push_back({uint32_t(edge.outcoming_slot), uint32_t(edge.incoming_slot),
+                                    uint32_t(attribute_ids.size()), uint32_t(token_line.size() - 3),
+                                    {edge.resistance.real(), edge.resistance.imag()},
+                                    {edge.emf.real(), edge.emf.imag()}});
+            for (size_t attribute = 3; attribute < token_line.size(); attribute++) {
+                attribute_ids.push_back(intern(token_line[attribute]));
+            }
+        }
+    }
+
+    header header_{};
+    std::copy(Magic, Magic + sizeof(Magic), header_.magic);
+    header_.version = Version;
+    header_.element_number = element_records.size();
+    header_.string_number = string_offsets.size() - 1;
+    header_.slot_number = slot_names.size();
+    header_.edge_number = edge_records.size();
+    header_.attribute_number = attribute_ids.size();
+    header_.string_data_size = string_data.size();
+    // Every section starts at an offset aligned to 8 bytes
+    auto get_aligned = [](uint64_t offset) { return (offset + 7) / 8 * 8; };
+    header_.string_offsets_offset = get_aligned(sizeof(header));
+    header_.elements_offset = get_aligned(header_.string_offsets_offset + string_offsets.size() * sizeof(uint64_t));
+    header_.edges_offset = get_aligned(header_.elements_offset + element_records.size() * sizeof(library_element));
+    header_.slots_offset = get_aligned(header_.edges_offset + edge_records.size() * sizeof(library_edge));
+    header_.attributes_offset = get_aligned(header_.slots_offset + slot_names.size() * sizeof(uint32_t));
+    header_.string_data_offset = get_aligned(header_.attributes_offset + attribute_ids.size() * sizeof(uint32_t));
+
+    uint64_t position = 0;
+    auto write_section = [&](uint64_t offset, const void *data, size_t size) {
+        for (; position < offset; position++) {
+            output.put('\0');
+        }
+        output.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        position += size;
+    };
+    write_section(0, &header_, sizeof(header_));
+    write_section(header_.string_offsets_offset, string_offsets.data(), string_offsets.size() * sizeof(uint64_t));
+    write_section(header_.elements_offset, element_records.data(), element_records.size() * sizeof(library_element));
+    write_section(header_.edges_offset, edge_records.data(), edge_records.size() * sizeof(library_edge));
+    write_section(header_.slots_offset, slot_names.data(), slot_names.size() * sizeof(uint32_t));
+    write_section(header_.attributes_offset, attribute_ids.data(), attribute_ids.size() * sizeof(uint32_t));
+    write_section(header_.string_data_offset, string_data.data(), string_data.size());
+}
+
+void element_library::compile(std::istream &input, const std::string &file_name, std::ostream &output) {
+    input_preworker preworker(input, file_name, 0, false);
+    preworker.perform_prework();
+    if (!preworker.get_edges().empty())
+        throw NotOnlyDefinitionsException();
+    std::vector<const input_preworker::element*> elements;
+    for (const auto &[name, element_] : preworker.compile_elements()) {
+        elements.push_back(&element_);
+    }
+    write(elements, output);
+}
@@ -0,0 +1,96 @@
+#ifndef CIRCUITS_ELEMENT_LIBRARY_H
+#define CIRCUITS_ELEMENT_LIBRARY_H
+
+#include <cstdint>
+#include <exception>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "input_parser.h"
+#include "input_preworker.h"
+
+// Element definitions compiled into a memory-mapped binary file in native byte order. Names are
+// interned into a string table, elements are sorted by name and decoded on lookup only.
+class element_library {
+public:
+    explicit element_library(const std::string& file_name);
+
+    bool contains(std::string_view name) const { return find(name) != nullptr; }
+    bool find_element(std::string_view name, input_preworker::element& element_) const;
+    std::vector<std::string> get_element_names() const;
+    size_t get_element_number() const { return header_->element_number; }
+
+    // Checks the magic bytes, the stream is rewound to its beginning
+    static bool is_library(std::istream& input);
+    static void write(const std::vector<const input_preworker::element*>& elements, std::ostream& output);
+    // Compiles all elements defined in the input and in its includes
+    static void compile(std::istream& input, const std::string& file_name, std::ostream& output);
+
+    static constexpr uint32_t Version = 1;
+
+    class InvalidLibraryException : public std::exception {
+        const char* what () const throw () { return "Element library is damaged or has unsupported version"; }
+    };
+
+    class NotOnlyDefinitionsException : public std::exception {
+        const char* what () const throw () { return "Element library must contain element definitions only"; }
+    };
+
+private:
+    struct header {
+        char magic[8];
+        uint32_t version;
+        uint32_t element_number;
+        uint64_t string_number;
+        uint64_t slot_number;
+        uint64_t edge_number;
+        uint64_t attribute_number;
+        uint64_t string_offsets_offset;
+        uint64_t string_data_offset;
+        uint64_t string_data_size;
+        uint64_t elements_offset;
+        uint64_t slots_offset;
+        uint64_t edges_offset;
+        uint64_t attributes_offset;
+    };
+
+    // Slots are names of the parameters followed by names of the internal variables
+    struct library_element {
+        uint32_t name;
+        uint32_t parameter_number;
+        uint32_t internal_number;
+        uint32_t edge_number;
+        uint64_t first_slot;
+        uint64_t first_edge;
+    };
+
+    // Attributes are the edge tokens kept for the text output
+    struct library_edge {
+        uint32_t outcoming_slot;
+        uint32_t incoming_slot;
+        uint32_t first_attribute;
+        uint32_t attribute_number;
+        double resistance[2];
+        double emf[2];
+    };
+
+    static constexpr char Magic[8] = {'C', 'I', 'R', 'C', 'L', 'I', 'B', '\n'};
+
+    mapped_input file;
+    const header* header_;
+    const uint64_t* string_offsets;
+    const char* string_data;
+    const library_element* elements;
+    const uint32_t* slots;
+    const library_edge* edges;
+    const uint32_t* attributes;
+
+    const library_element* find(std::string_view name) const;
+    std::string_view get_string(uint32_t string_index) const;
+    template <typename T>
+    const T* get_section(uint64_t offset, uint64_t number) const;
+};
+
+#endif //CIRCUITS_ELEMENT_LIBRARY_H
@@ -1,104 +1,270 @@
-#include <iterator>
 #include "graph.h"
 
 bool graph::add_edge(vertex first, vertex second) {
-    size_t max_vertex = std::max(first + 1, second + 1);
-    resize_structures(max_vertex);
+    // The largest id is reserved, the vertex number and the edge number have to fit the id type
+    if (std::max(first, second) == std::numeric_limits<vertex>::max() ||
+        edges_vertices.size() >= std::numeric_limits<edge>::max())
+        throw IdOverflowException();
+    vertex_number = std::max<size_t>(vertex_number, std::max(first, second) + size_t(1));
+    is_adjacency_built = false;
     if (first == second) {
         loops.push_back(first);
         return false;
     }
-    edge current = edges_vertices.size();
-    outcoming_edges[first].push_back(current);
-    incoming_edges[second].push_back(current);
     edges_vertices.emplace_back(first, second);
     return true;
 }
 
-void graph::resize_structures(size_t necessary_size) {
-    if (necessary_size > incoming_edges.size()) {
-        incoming_edges.resize(necessary_size);
-        outcoming_edges.resize(necessary_size);
+void graph::build_adjacency() const {
+    if (is_adjacency_built)
+        return;
+    fill_adjacency(outcoming_offsets, outcoming_adjacency, true);
+    fill_adjacency(incoming_offsets, incoming_adjacency, false);
+    is_adjacency_built = true;
+}
+
+void graph::fill_adjacency(std::vector<edge> &offsets, std::vector<edge> &adjacency, bool is_outcoming) const {
+    offsets.assign(vertex_number + 1, 0);
+    for (const auto& [first, second] : edges_vertices) {
+        offsets[(is_outcoming ? first : second) + 1]++;
+    }
+    for (size_t vertex_ = 1; vertex_ < offsets.size(); vertex_++) {
+        offsets[vertex_] += offsets[vertex_ - 1];
+    }
+    std::vector<edge> next_position(offsets.begin(), offsets.end() - 1);
+    adjacency.resize(edges_vertices.size());
+    for (edge edge_ = 0; edge_ < edges_vertices.size(); edge_++) {
+        const auto& [first, second] = edges_vertices[edge_];
+        adjacency[next_position[is_outcoming ? first : second]++] = edge_;
+    }
+    adjacency.shrink_to_fit();
+}
+
+graph::edge_range graph::get_incoming_edges(vertex vertex_) const {
+    build_adjacency();
+    return {incoming_adjacency.data() + incoming_offsets[vertex_], incoming_adjacency.data() + incoming_offsets[vertex_ + 1]};
+}
+
+graph::edge_range graph::get_outcoming_edges(vertex vertex_) const {
+    build_adjacency();
+    return {outcoming_adjacency.data() + outcoming_offsets[vertex_],
+            outcoming_adjacency.data() + outcoming_offsets[vertex_ + 1]};
+}
+
+size_t graph::get_vertex_degree(vertex vertex_) const {
+    build_adjacency();
+    return incoming_offsets[vertex_ + 1] - incoming_offsets[vertex_] +
+           outcoming_offsets[vertex_ + 1] - outcoming_offsets[vertex_];
+}
+
+graph::subgraph_partition graph::get_coherent_subgraphs() const {
+    subgraph_partition partition;
+    fill_partition_vertices(partition);
+    fill_partition_edges(partition);
+    return partition;
+}
+
+std::vector<graph::vertex> graph::get_component_roots() const {
+    std::vector<vertex> parent(get_vertex_number()), component_size(get_vertex_number(), 1);
+    for (vertex vertex_ = 0; vertex_ < parent.size(); vertex_++) {
+        parent[vertex_] = vertex_;
+    }
+    auto find_root = [&parent](vertex vertex_) {
+        while (parent[vertex_] != vertex_) {
+            parent[vertex_] = parent[parent[vertex_]];
+            vertex_ = parent[vertex_];
+        }
+        return vertex_;
+    };
+    for (const auto& [first, second] : edges_vertices) {
+        vertex first_root = find_root(first), second_root = find_root(second);
+        if (first_root == second_root)
+            continue;
+        if (component_size[first_root] < component_size[second_root])
+            std::swap(first_root, second_root);
+        parent[second_root] = first_root;
+        component_size[first_root] += component_size[second_root];
     }
+    for (vertex vertex_ = 0; vertex_ < parent.size(); vertex_++) {
+        parent[vertex_] = find_root(vertex_);
+    }
+    return parent;
 }
 
-std::vector<graph> graph::get_coherent_subgraphs() const {
-    std::vector<graph> subgraphs;
-    std::set<vertex> all_vertices = get_all_vertices_set();
-    while (!all_vertices.empty()) {
-        std::set<vertex> isolated_vertices;
-        dfs(isolated_vertices, *all_vertices.begin());
-        modify_all_vertices_set(all_vertices, isolated_vertices);
-        fill_subgraph_vertices_mapping(isolated_vertices);
-        auto subgraph = fill_subgraph(subgraphs.size(), isolated_vertices);
-        subgraphs.push_back(subgraph);
+void graph::fill_partition_vertices(subgraph_partition &partition) const {
+    const auto component_roots = get_component_roots();
+    std::vector<size_t> root_subgraph(get_vertex_number(), get_vertex_number());
+    auto& vertex_offsets = partition.vertex_offsets;
+    auto& vertex_subgraphs = partition.vertex_subgraphs;
+    vertex_subgraphs.resize(get_vertex_number());
+    for (vertex vertex_ = 0; vertex_ < get_vertex_number(); vertex_++) {
+        auto& subgraph_index = root_subgraph[component_roots[vertex_]];
+        if (subgraph_index == get_vertex_number()) {
+            subgraph_index = vertex_offsets.size() - 1;
+            vertex_offsets.push_back(0);
+        }
+        vertex_subgraphs[vertex_] = static_cast<vertex>(subgraph_index);
+        vertex_offsets[subgraph_index + 1]++;
+    }
+    for (size_t subgraph_index = 1; subgraph_index < vertex_offsets.size(); subgraph_index++) {
+        vertex_offsets[subgraph_index] += vertex_offsets[subgraph_index - 1];
+    }
+
+    std::vector<size_t> next_position(vertex_offsets.begin(), vertex_offsets.end() - 1);
+    partition.subgraph_vertices.resize(get_vertex_number());
+    partition.vertex_positions.resize(get_vertex_number());
+    for (vertex vertex_ = 0; vertex_ < get_vertex_number(); vertex_++) {
+        const size_t position = next_position[vertex_subgraphs[vertex_]]++;
+        partition.subgraph_vertices[position] = vertex_;
+        partition.vertex_positions[vertex_] = position;
     }
-    return subgraphs;
 }
 
-void graph::modify_all_vertices_set(std::set<vertex> &all_vertices, const std::set<vertex> &isolated_vertices) const {
-    std::set<vertex> unvisited_vertices;
-    std::set_difference(all_vertices.begin(), all_vertices.end(),
-                        isolated_vertices.begin(), isolated_vertices.end(),
-                        std::inserter(unvisited_vertices, unvisited_vertices.end()));
-    all_vertices = std::move(unvisited_vertices);
+void graph::fill_partition_edges(subgraph_partition &partition) const {
+    partition.subgraph_edges.reserve(get_edge_number());
+    partition.edge_positions.resize(get_edge_number());
+    partition.edge_subgraphs.resize(get_edge_number());
+    for (size_t subgraph_index = 0; subgraph_index < partition.size(); subgraph_index++) {
+        for (size_t position = partition.vertex_offsets[subgraph_index];
+             position < partition.vertex_offsets[subgraph_index + 1]; position++) {
+            for (auto edge_ : get_outcoming_edges(partition.subgraph_vertices[position])) {
+                partition.edge_positions[edge_] = partition.subgraph_edges.size();
+                partition.edge_subgraphs[edge_] = static_cast<vertex>(subgraph_index);
+                partition.subgraph_edges.push_back(edge_);
+            }
+        }
+        partition.edge_offsets.push_back(partition.subgraph_edges.size());
+    }
 }
 
-std::set<graph::vertex> graph::get_all_vertices_set() const {
-    std::set<vertex> all_vertices;
-    for (size_t vertex_index = 0; vertex_index < outcoming_edges.size(); vertex_index++) {
-        all_vertices.insert(vertex_index);
+std::vector<graph::edges> graph::get_biconnected_components() const {
+    struct dfs_frame {
+        vertex vertex_;
+        edge parent_edge;
+        size_t next_edge_index;
+    };
+    const edge no_edge = static_cast<edge>(edges_vertices.size());
+    build_adjacency();
+    std::vector<vertex> discovery_time(get_vertex_number(), 0), low_time(get_vertex_number(), 0);
+    std::vector<dfs_frame> dfs_stack;
+    edges edge_stack;
+    std::vector<edges> components;
+    vertex time = 0;
+    for (vertex root = 0; root < get_vertex_number(); root++) {
+        if (discovery_time[root])
+            continue;
+        discovery_time[root] = low_time[root] = ++time;
+        dfs_stack.push_back({root, no_edge, 0});
+        while (!dfs_stack.empty()) {
+            auto& frame = dfs_stack.back();
+            const vertex current_vertex = frame.vertex_;
+            if (frame.next_edge_index < get_vertex_degree(current_vertex)) {
+                const edge edge_ = get_vertex_edge(current_vertex, frame.next_edge_index++);
+                if (edge_ == frame.parent_edge)
+                    continue;
+                const vertex adjacent_vertex = get_adjacent_vertex(edge_, current_vertex);
+                if (!discovery_time[adjacent_vertex]) {
+                    edge_stack.push_back(edge_);
+                    discovery_time[adjacent_vertex] = low_time[adjacent_vertex] = ++time;
+                    dfs_stack.push_back({adjacent_vertex, edge_, 0});
+                } else if (discovery_time[adjacent_vertex] < discovery_time[current_vertex]) {
+                    edge_stack.push_back(edge_);
+                    low_time[current_vertex] = std::min(low_time[current_vertex], discovery_time[adjacent_vertex]);
+                }
+                continue;
+            }
+            const edge parent_edge = frame.parent_edge;
+            dfs_stack.pop_back();
+            if (dfs_stack.empty())
+                break;
+            const vertex parent_vertex = dfs_stack.back().vertex_;
+            low_time[parent_vertex] = std::min(low_time[parent_vertex], low_time[current_vertex]);
+            if (low_time[current_vertex] >= discovery_time[parent_vertex]) {
+                edges component;
+                edge component_edge;
+                do {
+                    component_edge = edge_stack.back();
+                    edge_stack.pop_back();
+                    component.push_back(component_edge);
+                } while (component_edge != parent_edge);
+                std::sort(component.begin(), component.end());
+                components.push_back(std::move(component));
+            }
+        }
     }
-    return all_vertices;
+    std::sort(components.begin(), components.end(), [](const edges& first, const edges& second) {
+        return first.front() < second.front();
+    });
+    return components;
 }
 
-graph graph::fill_subgraph(size_t subgraph_index, std::set<vertex> &isolated_vertices) const {
+graph graph::get_edges_subgraph(const edges& subgraph_edges) const {
+    std::vector<vertex> subgraph_vertices;
+    subgraph_vertices.reserve(2 * subgraph_edges.size());
+    for (auto edge_ : subgraph_edges) {
+        subgraph_vertices.push_back(edges_vertices[edge_].first);
+        subgraph_vertices.push_back(edges_vertices[edge_].second);
+    }
+    std::sort(subgraph_vertices.begin(), subgraph_vertices.end());
+    subgraph_vertices.erase(std::unique(subgraph_vertices.begin(), subgraph_vertices.end()), subgraph_vertices.end());
+
+    auto get_subgraph_vertex = [&subgraph_vertices](vertex vertex_) {
+        return static_cast<vertex>(std::lower_bound(subgraph_vertices.begin(), subgraph_vertices.end(), vertex_) -
+                                   subgraph_vertices.begin());
+    };
     graph subgraph;
-    size_t subgraph_edge_index = 0;
-    for (auto vertex_ : isolated_vertices) {
-        for (auto edge_index : outcoming_edges[vertex_]) {
-            auto edge = edges_vertices[edge_index];
-            subgraph.add_edge(subgraph_vertices_mapping[edge.first],
-                              subgraph_vertices_mapping[edge.second]);
-            subgraph_edges_mapping[{subgraph_index, subgraph_edge_index++}] = edge_index;
-        }
+    for (auto edge_ : subgraph_edges) {
+        subgraph.add_edge(get_subgraph_vertex(edges_vertices[edge_].first),
+                          get_subgraph_vertex(edges_vertices[edge_].second));
     }
     return subgraph;
 }
 
-void graph::fill_subgraph_vertices_mapping(std::set<vertex> &isolated_vertices) const {
-    vertex subgraph_vertex = 0;
-    for (auto vertex_ : isolated_vertices) {
-        subgraph_vertices_mapping[vertex_] = subgraph_vertex++;
-    }
+graph::vertex graph::get_adjacent_vertex(edge edge_, vertex vertex_) const {
+    const auto& [source, destination] = edges_vertices[edge_];
+    return source == vertex_ ? destination : source;
+}
+
+graph::edge graph::get_vertex_edge(vertex vertex_, size_t edge_index) const {
+    const size_t outcoming_edge_number = outcoming_offsets[vertex_ + 1] - outcoming_offsets[vertex_];
+    if (edge_index < outcoming_edge_number)
+        return outcoming_adjacency[outcoming_offsets[vertex_] + edge_index];
+    return incoming_adjacency[incoming_offsets[vertex_] + edge_index - outcoming_edge_number];
 }
 
 void graph::check_connectivity() const {
-    std::set<vertex> isolated_vertices;
-    dfs(isolated_vertices, 0);
-    if (isolated_vertices.size() != incoming_edges.size()) {
-        print_isolated_vertices(isolated_vertices);
+    auto reachable_vertices = get_reachable_vertices(0);
+    const size_t reachable_vertex_number = std::count(reachable_vertices.begin(), reachable_vertices.end(), true);
+    if (reachable_vertex_number != get_vertex_number()) {
+        print_isolated_vertices(reachable_vertices);
         throw IncoherentGraphException();
     }
 }
 
-void graph::print_isolated_vertices(const std::set<vertex> &isolated_vertices) const {
+void graph::print_isolated_vertices(const std::vector<bool> &reachable_vertices) const {
     std::cout << "Isolated vertices: ";
-    for (auto vertex_ : isolated_vertices)
-        std::cout << vertex_ + 1 << " ";
+    for (vertex vertex_ = 0; vertex_ < reachable_vertices.size(); vertex_++)
+        if (reachable_vertices[vertex_])
+            std::cout << vertex_ + 1 << " ";
     std::cout << std::endl;
 }
 
-void graph::dfs(std::set<vertex>& visited_vertices, vertex current_vertex) const {
-    visited_vertices.insert(current_vertex);
-    for (auto edge_ : incoming_edges[current_vertex]) {
-        auto [source, destination] = edges_vertices[edge_];
-        if (!visited_vertices.count(source))
-            dfs(visited_vertices, source);
-    }
-    for (auto edge_ : outcoming_edges[current_vertex]) {
-        auto [source, destination] = edges_vertices[edge_];
-        if (!visited_vertices.count(destination))
-            dfs(visited_vertices, destination);
+std::vector<bool> graph::get_reachable_vertices(vertex start_vertex) const {
+    std::vector<bool> reachable_vertices(get_vertex_number(), false);
+    if (start_vertex >= get_vertex_number())
+        return reachable_vertices;
+    build_adjacency();
+    std::vector<vertex> vertex_queue{start_vertex};
+    reachable_vertices[start_vertex] = true;
+    for (size_t queue_index = 0; queue_index < vertex_queue.size(); queue_index++) {
+        const vertex current_vertex = vertex_queue[queue_index];
+        for (size_t edge_index = 0; edge_index < get_vertex_degree(current_vertex); edge_index++) {
+            const vertex adjacent_vertex = get_adjacent_vertex(get_vertex_edge(current_vertex, edge_index), current_vertex);
+            if (!reachable_vertices[adjacent_vertex]) {
+                reachable_vertices[adjacent_vertex] = true;
+                vertex_queue.push_back(adjacent_vertex);
+            }
+        }
     }
-}
\ No newline at end of file
+    return reachable_vertices;
+}
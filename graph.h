@@ -1,54 +1,111 @@
 #ifndef CIRCUITS_GRAPH_H
 #define CIRCUITS_GRAPH_H
 
+#include <cstdint>
+#include <limits>
 #include <vector>
-#include <set>
 #include <iostream>
 #include <algorithm>
-#include <map>
 
 class graph {
 public:
-    typedef size_t edge;
-    typedef size_t vertex;
+    typedef uint32_t edge;
+    typedef uint32_t vertex;
     typedef std::vector<edge> edges;
     typedef std::pair<vertex, vertex> tied_vertices;
-    typedef std::pair<size_t, edge> subgraph_mapping_key;
+
+    class edge_range {
+    public:
+        edge_range(const edge* first_, const edge* last_): first(first_), last(last_) {}
+        const edge* begin() const { return first; }
+        const edge* end() const { return last; }
+        size_t size() const { return last - first; }
+        bool empty() const { return first == last; }
+        edge operator[](size_t index) const { return first[index]; }
+    private:
+        const edge* first;
+        const edge* last;
+    };
 
     bool add_edge(vertex first, vertex second);
+    // Adjacency is built in bulk on first use, build it before sharing the graph between threads
+    void build_adjacency() const;
     size_t get_edge_number() const { return edges_vertices.size(); }
-    size_t get_vertex_number() const { return incoming_edges.size(); }
-    const edges& get_incoming_edges(vertex vertex_) const { return incoming_edges[vertex_]; }
-    const edges& get_outcoming_edges(vertex vertex_) const { return outcoming_edges[vertex_]; }
+    size_t get_vertex_number() const { return vertex_number; }
+    edge_range get_incoming_edges(vertex vertex_) const;
+    edge_range get_outcoming_edges(vertex vertex_) const;
+    size_t get_vertex_degree(vertex vertex_) const;
     const tied_vertices& get_tied_vertices(edge edge_) const { return edges_vertices[edge_]; }
-    edge get_subgraph_mapping_edge(subgraph_mapping_key key) const { return subgraph_edges_mapping[key]; }
     const std::vector<vertex>& get_loops() const { return loops; }
 
+    class subgraph_partition {
+    public:
+        size_t size() const { return vertex_offsets.size() - 1; }
+        size_t get_vertex_number(size_t subgraph_index) const {
+            return vertex_offsets[subgraph_index + 1] - vertex_offsets[subgraph_index];
+        }
+        size_t get_edge_number(size_t subgraph_index) const {
+            return edge_offsets[subgraph_index + 1] - edge_offsets[subgraph_index];
+        }
+        vertex get_vertex(size_t subgraph_index, vertex subgraph_vertex) const {
+            return subgraph_vertices[vertex_offsets[subgraph_index] + subgraph_vertex];
+        }
+        edge get_edge(size_t subgraph_index, edge subgraph_edge) const {
+            return subgraph_edges[edge_offsets[subgraph_index] + subgraph_edge];
+        }
+        size_t get_edge_position(edge edge_) const { return edge_positions[edge_]; }
+        size_t get_vertex_subgraph(vertex vertex_) const { return vertex_subgraphs[vertex_]; }
+        size_t get_edge_subgraph(edge edge_) const { return edge_subgraphs[edge_]; }
+        vertex get_subgraph_vertex(vertex vertex_) const {
+            return vertex_positions[vertex_] - vertex_offsets[vertex_subgraphs[vertex_]];
+        }
+        edge get_subgraph_edge(edge edge_) const {
+            return edge_positions[edge_] - edge_offsets[edge_subgraphs[edge_]];
+        }
+
+    private:
+        friend class graph;
+        std::vector<vertex> subgraph_vertices;
+        std::vector<size_t> vertex_offsets{0};
+        std::vector<vertex> vertex_positions;
+        std::vector<edge> subgraph_edges;
+        std::vector<size_t> edge_offsets{0};
+        std::vector<edge> edge_positions;
+        // There are no more subgraphs than vertices, so subgraph indices fit the vertex type
+        std::vector<vertex> vertex_subgraphs;
+        std::vector<vertex> edge_subgraphs;
+    };
+
     void check_connectivity() const;
-    std::vector<graph> get_coherent_subgraphs() const;
-    void dfs(std::set<vertex>& visited_vertices, vertex current_vertex) const;
+    subgraph_partition get_coherent_subgraphs() const;
+    std::vector<edges> get_biconnected_components() const;
+    graph get_edges_subgraph(const edges& subgraph_edges) const;
+    std::vector<bool> get_reachable_vertices(vertex start_vertex) const;
     class IncoherentGraphException : public std::exception {
         const char* what () const throw () { return "Circuit graph is incoherent!"; }
     };
+    class IdOverflowException : public std::exception {
+        const char* what () const throw () { return "Vertex or edge id exceeds the id type"; }
+    };
 private:
-    std::vector<edges> incoming_edges;
-    std::vector<edges> outcoming_edges;
+    size_t vertex_number = 0;
     std::vector<tied_vertices> edges_vertices;
     std::vector<vertex> loops;
 
-    mutable std::map<subgraph_mapping_key, edge> subgraph_edges_mapping;
-    mutable std::map<vertex, vertex> subgraph_vertices_mapping;
-
-    void resize_structures(size_t necessary_size);
-    void print_isolated_vertices(const std::set<vertex> &isolated_vertices) const;
-
-    void fill_subgraph_vertices_mapping(std::set<vertex> &isolated_vertices) const;
-
-    graph fill_subgraph(size_t subgraph_index, std::set<vertex> &isolated_vertices) const;
+    mutable bool is_adjacency_built = true;
+    mutable std::vector<edge> incoming_offsets{0};
+    mutable std::vector<edge> incoming_adjacency;
+    mutable std::vector<edge> outcoming_offsets{0};
+    mutable std::vector<edge> outcoming_adjacency;
 
-    std::set<vertex> get_all_vertices_set() const;
+    void fill_adjacency(std::vector<edge> &offsets, std::vector<edge> &adjacency, bool is_outcoming) const;
+    vertex get_adjacent_vertex(edge edge_, vertex vertex_) const;
+    edge get_vertex_edge(vertex vertex_, size_t edge_index) const;
+    void print_isolated_vertices(const std::vector<bool> &reachable_vertices) const;
 
-    void modify_all_vertices_set(std::set<vertex> &all_vertices, const std::set<vertex> &isolated_vertices) const;
+    std::vector<vertex> get_component_roots() const;
+    void fill_partition_vertices(subgraph_partition &partition) const;
+    void fill_partition_edges(subgraph_partition &partition) const;
 };
 
 
@@ -1,6 +1,32 @@
-#include <iostream>
+#include <algorithm>
+#include <charconv>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "input_parser.h"
 
+input_parser::InvalidInputException::InvalidInputException(char character_, size_t line_, size_t column_):
+    message("Unexpected character: " + std::string(1, character_) + " at line " + std::to_string(line_) +
+            ", column " + std::to_string(column_)),
+    character(character_),
+    line(line_),
+    column(column_)
+{}
+
+input_parser::input_parser(std::string_view input_string, bool is_ac_, const cursor &start):
+    input(input_string),
+    position(start.position),
+    is_ac(is_ac_),
+    temporary_emf(start.pending_vertex),
+    temporary_emf_position(start.pending_position),
+    is_previous_has_emf(!start.is_vertex_pending)
+{}
+
+input_parser::cursor input_parser::get_cursor() const {
+    return {position, !is_previous_has_emf, temporary_emf, temporary_emf_position};
+}
+
 void input_parser::make_iteration() {
     fill_outcoming_vertex();
     check_symbol(Vertex_separator);
@@ -13,7 +39,7 @@ void input_parser::make_iteration() {
     }
     check_symbol(Characteristic_separator);
     fill_emf();
-    input >> std::ws;
+    skip_whitespace();
 }
 
 void input_parser::make_ac_iteration() {
@@ -24,40 +50,76 @@ void input_parser::make_ac_iteration() {
     fill_inductance();
 }
 
+namespace {
+bool is_whitespace(char character) {
+    return character == ' ' || (character >= '\t' && character <= '\r');
+}
+
+bool is_digit(int character) {
+    return character >= '0' && character <= '9';
+}
+}
+
+void input_parser::skip_whitespace() {
+    while (position < input.size() && is_whitespace(input[position]))
+        position++;
+}
+
 bool input_parser::check_symbol(const char separator) {
-    if (input.peek() == separator) {
-        input.ignore(1);
+    if (peek() == separator) {
+        position++;
         return true;
     }
     return false;
 }
 
 void input_parser::check_numeric() {
-    if (input.peek() == '-') {
-        input.get();
-        if (!isdigit(input.peek())) {
-            input.unget();
-        } else {
-            input.unget();
-            return;
-        }
-    }
-    if (!isdigit(input.peek()) && input.peek() != EOF) {
-        std::cout << "Unexpected character: " << static_cast<char>(input.peek()) << std::endl;
-        throw InvalidInputException();
-    }
+    const int character = peek();
+    if (is_digit(character) || character == EOF)
+        return;
+    if (character == '-' && position + 1 < input.size() && is_digit(input[position + 1]))
+        return;
+    throw_unexpected_character();
+}
+
+void input_parser::throw_unexpected_character() const {
+    const auto parsed = input.substr(0, position);
+    const size_t line = std::count(parsed.begin(), parsed.end(), '\n') + 1;
+    const size_t line_begin = parsed.rfind('\n');
+    const size_t column = line_begin == std::string_view::npos ? position + 1 : position - line_begin;
+    throw InvalidInputException(input[position], line, column);
+}
+
+double input_parser::read_number() {
+    double number = 0.;
+    auto [end, error] = std::from_chars(input.data() + position, input.data() + input.size(), number);
+    if (error == std::errc::invalid_argument)
+        return number;
+    position = end - input.data();
+    return number;
+}
+
+graph::vertex input_parser::read_vertex() {
+    graph::vertex vertex = 0;
+    auto [end, error] = std::from_chars(input.data() + position, input.data() + input.size(), vertex);
+    if (error == std::errc::result_out_of_range || (error == std::errc::invalid_argument && !is_eof()))
+        throw_unexpected_character();
+    position = end - input.data();
+    return vertex;
 }
 
 void input_parser::fill_emf() {
-    input >> std::ws;
+    skip_whitespace();
     check_numeric();
-    input >> temporary_emf >> std::ws;
+    temporary_emf_position = position;
+    temporary_emf = read_number();
+    skip_whitespace();
     if (check_symbol(EMF_dimension)) {
         is_previous_has_emf = true;
         double phase = get_emf_phase();
         current_edge_info.emf = std::polar(temporary_emf, phase);
         check_symbol(Characteristic_separator);
-        input >> std::ws;
+        skip_whitespace();
         return;
     }
 
@@ -69,28 +131,30 @@ void input_parser::fill_resistance() {
 }
 
 double input_parser::get_impedance() {
-    input >> std::ws;
+    skip_whitespace();
     check_numeric();
-    double impedance = 0.;
-    input >> impedance >> std::ws;
+    double impedance = read_number();
+    skip_whitespace();
     return impedance;
 }
 
 void input_parser::fill_incoming_vertex() {
-    input >> std::ws;
+    skip_whitespace();
     check_numeric();
-    input >> current_edge_info.incoming_vertex >> std::ws;
+    current_edge_info.incoming_vertex = read_vertex();
+    skip_whitespace();
 }
 
 void input_parser::fill_outcoming_vertex() {
     if (!is_previous_has_emf) {
-        current_edge_info.outcoming_vertex = static_cast<size_t>(temporary_emf);
+        current_edge_info.outcoming_vertex = static_cast<graph::vertex>(temporary_emf);
         return;
     }
 
-    input >> std::ws;
+    skip_whitespace();
     check_numeric();
-    input >> current_edge_info.outcoming_vertex >> std::ws;
+    current_edge_info.outcoming_vertex = read_vertex();
+    skip_whitespace();
 }
 
 void input_parser::fill_capacity() {
@@ -107,9 +171,36 @@ double input_parser::get_emf_phase() {
     if (!is_ac)
         return 0;
     check_symbol(Input_separator);
-    input >> std::ws;
+    skip_whitespace();
     check_numeric();
-    double phase = 0.;
-    input >> phase >> std::ws;
+    double phase = read_number();
+    skip_whitespace();
     return -phase / 180 * M_PI;
 }
+
+mapped_input::mapped_input(const std::string &file_name) {
+    int descriptor = open(file_name.c_str(), O_RDONLY);
+    if (descriptor == -1)
+        throw FileOpenException();
+    struct stat file_status{};
+    if (fstat(descriptor, &file_status) == -1) {
+        close(descriptor);
+        throw FileOpenException();
+    }
+    size = file_status.st_size;
+    if (size > 0) {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapping == MAP_FAILED) {
+            close(descriptor);
+            throw FileOpenException();
+        }
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(mapping);
+    }
+    close(descriptor);
+}
+
+mapped_input::~mapped_input() {
+    if (data != nullptr)
+        munmap(const_cast<char*>(data), size);
+}
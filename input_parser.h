@@ -4,7 +4,7 @@
 
 #include <complex>
 #include <string>
-#include <sstream>
+#include <string_view>
 #include "graph.h"
 
 class input_parser {
@@ -15,25 +15,51 @@ public:
         std::complex<double> resistance;
         std::complex<double> emf;
     };
-    input_parser(const std::string& input_string): input(input_string) {
-        is_ac = input_string.find('C') != std::string::npos;
+    // Resumable parsing position: the vertex number after an edge without EMF is read ahead
+    struct cursor {
+        size_t position = 0;
+        bool is_vertex_pending = false;
+        double pending_vertex = 0.;
+        size_t pending_position = 0;
     };
+    // The parser does not copy the input, it has to outlive the parser
+    explicit input_parser(std::string_view input_string): input(input_string) {
+        is_ac = is_alternating_current(input_string);
+    };
+    input_parser(std::string_view input_string, bool is_ac_, const cursor& start);
     void make_iteration();
-    bool is_eof() { return input.peek() == EOF; }
+    bool is_eof() const { return position == input.size(); }
     bool is_alternating_current() const { return is_ac; }
+    static bool is_alternating_current(std::string_view input_string) {
+        return input_string.find(Capacity_dimension) != std::string_view::npos;
+    }
+    cursor get_cursor() const;
+    size_t get_next_edge_position() const { return is_previous_has_emf ? position : temporary_emf_position; }
 
     state get_current_edge_info() const { return current_edge_info; }
 
     bool is_emf_included() const { return is_previous_has_emf; }
 
-    class InvalidInputException : std::exception {
-        const char* what () const throw () { return "Unexpected character in input line!"; }
+    class InvalidInputException : public std::exception {
+    public:
+        InvalidInputException(char character_, size_t line_, size_t column_);
+        const char* what () const throw () { return message.c_str(); }
+        char get_character() const { return character; }
+        size_t get_line() const { return line; }
+        size_t get_column() const { return column; }
+    private:
+        std::string message;
+        char character;
+        size_t line;
+        size_t column;
     };
 
 private:
-    std::stringstream input;
+    std::string_view input;
+    size_t position = 0;
     bool is_ac = false;
     double temporary_emf = 0.;
+    size_t temporary_emf_position = 0;
     state current_edge_info;
     bool is_previous_has_emf = true;
 
@@ -49,21 +75,43 @@ private:
 
     double get_emf_phase();
 
-    const char EMF_dimension = 'V';
-    const char Resistance_dimension = 'R';
-    const char Capacity_dimension = 'C';
-    const char Inductance_dimension = 'L';
-    const char Vertex_separator = '-';
-    const char Input_separator = ',';
-    const char Characteristic_separator = ';';
+    static constexpr char EMF_dimension = 'V';
+    static constexpr char Resistance_dimension = 'R';
+    static constexpr char Capacity_dimension = 'C';
+    static constexpr char Inductance_dimension = 'L';
+    static constexpr char Vertex_separator = '-';
+    static constexpr char Input_separator = ',';
+    static constexpr char Characteristic_separator = ';';
 
+    int peek() const { return position < input.size() ? static_cast<unsigned char>(input[position]) : EOF; }
+    void skip_whitespace();
     bool check_symbol(const char separator);
     void check_numeric();
+    double read_number();
+    graph::vertex read_vertex();
+    [[noreturn]] void throw_unexpected_character() const;
 
     void make_ac_iteration();
 
     double get_impedance();
 };
 
+class mapped_input {
+public:
+    explicit mapped_input(const std::string& file_name);
+    mapped_input(const mapped_input&) = delete;
+    mapped_input& operator=(const mapped_input&) = delete;
+    ~mapped_input();
+    std::string_view get_view() const { return std::string_view(data, size); }
+
+    class FileOpenException : public std::exception {
+        const char* what () const throw () { return "Input file failed to open!"; }
+    };
+
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+};
+
 
 #endif //CIRCUITS_INPUT_PARSER_H
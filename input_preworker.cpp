@@ -1,48 +1,92 @@
+#include <filesystem>
 #include <fstream>
 #include <algorithm>
+#include <charconv>
+#include <cmath>
 #include "input_preworker.h"
+#include "element_library.h"
 
-input_preworker::input_preworker(std::istream& input, const std::string& file, int max_vertex) {
+input_preworker::input_preworker(std::istream& input, const std::string& file, int max_vertex, bool is_text_output_,
+                                 size_t thread_number_):
+    is_text_output(is_text_output_),
+    thread_number(std::max<size_t>(thread_number_, 1)),
+    is_main_input(true),
+    source(read_input(input, file)),
+    lines(source->lines),
+    context(std::make_shared<prework_context>(thread_number)),
+    vertex_number(std::max(max_vertex, source->max_vertex))
+{
     file_name_ = file;
-    vertex_number = max_vertex;
     if (file_name_ != "input") {
         auto position = file_name_.find_last_of('/');
         if (position != std::string::npos) {
             file_path = file_name_.substr(0, position + 1);
         }
+        context->loader.enter_file(file_name_);
     }
-    tokenize(input);
 }
 
-void input_preworker::tokenize(std::istream &input) {
+input_preworker::input_preworker(std::shared_ptr<const parsed_file> file, int max_vertex, bool is_text_output_,
+                                 size_t thread_number_, std::shared_ptr<prework_context> context_):
+    file_name_(file->file_name),
+    is_text_output(is_text_output_),
+    thread_number(thread_number_),
+    is_main_input(false),
+    source(std::move(file)),
+    lines(source->lines),
+    context(std::move(context_)),
+    vertex_number(std::max(max_vertex, source->max_vertex))
+{
+    auto position = file_name_.find_last_of('/');
+    if (position != std::string::npos) {
+        file_path = file_name_.substr(0, position + 1);
+    }
+}
+
+std::shared_ptr<const input_preworker::parsed_file> input_preworker::read_input(std::istream &input,
+                                                                               const std::string &file_name) {
+    auto file = std::make_shared<parsed_file>();
+    file->file_name = file_name;
+    tokenize(input, *file);
+    if (!file->invalid_line.empty()) {
+        std::cout << file->invalid_line << std::endl;
+        throw UnexpectedTokenException();
+    }
+    return file;
+}
+
+void input_preworker::tokenize(std::istream &input, parsed_file &file) {
     Scanner scanner(&input);
+    std::vector<std::string_view> fields;
     for (;;) {
-        switch (scanner.get_next_token()) {
+        const auto token = scanner.get_next_token();
+        const std::string_view line(scanner.YYText(), scanner.YYLeng());
+        switch (token) {
             case Scanner::Token::END:
                 break;
             case Scanner::Token::INCLUDE_LINE:
-                tokenize_include(scanner);
+                tokenize_two_token_line(line, line_kind::include, fields, file);
                 continue;
             case Scanner::Token::DEFINE_LINE:
-                tokenize_define(scanner);
+                tokenize_define(line, fields, file);
                 continue;
             case Scanner::Token::INTERNAL_LINE:
-                tokenize_internal(scanner);
+                tokenize_two_token_line(line, line_kind::internal, fields, file);
                 continue;
             case Scanner::Token::ELEMENT_LINE:
-                tokenize_element_edge(scanner);
+                tokenize_element_edge(line, fields, file);
                 continue;
             case Scanner::Token::EDGE_LINE:
-                tokenize_edge(scanner);
+                tokenize_edge(line, fields, file);
                 continue;
             case Scanner::Token::CALL_LINE:
-                tokenize_substitution(scanner);
+                tokenize_substitution(line, fields, file);
                 continue;
             case Scanner::Token::INVALID_LINE:
-                std::cout << "Invalid line " << scanner.lineno() << ": " << scanner.YYText() << std::endl;
-                throw UnexpectedTokenException();
+                file.invalid_line = "Invalid line " + std::to_string(scanner.lineno()) + ": " + std::string(line);
+                break;
             case Scanner::Token::EOL:
-                tokens.emplace_back(1);
+                file.lines.emplace_back();
                 continue;
             default:
                 break;
@@ -51,264 +95,600 @@ void input_preworker::tokenize(std::istream &input) {
     }
 }
 
-void input_preworker::tokenize_substitution(const Scanner &scanner) {
-    std::stringstream call_line_ = simplify_element_line(scanner);
-    std::vector<std::string> call_tokens(1);
-    call_line_ >> call_tokens[0] >> std::ws;
-    while (true) {
-        int vertex = 0;
-        call_line_ >> vertex >> std::ws;
+void input_preworker::split_line(std::string_view line, std::string_view separators,
+                                 std::vector<std::string_view> &fields) {
+    fields.clear();
+    size_t field_begin = 0;
+    for (size_t position = 0; position < line.size(); position++) {
+        if (separators.find(line[position]) == std::string_view::npos)
+            continue;
+        if (position > field_begin)
+            fields.push_back(line.substr(field_begin, position - field_begin));
+        field_begin = position + 1;
+    }
+    if (line.size() > field_begin)
+        fields.push_back(line.substr(field_begin));
+}
+
+std::string_view input_preworker::get_field(const std::vector<std::string_view> &fields, size_t field_index) {
+    return field_index < fields.size() ? fields[field_index] : std::string_view();
+}
+
+int input_preworker::get_integer(std::string_view field) {
+    if (!field.empty() && field[0] == '+')
+        field.remove_prefix(1);
+    int value = 0;
+    std::from_chars(field.data(), field.data() + field.size(), value);
+    return value;
+}
+
+double input_preworker::get_value(std::string_view field) {
+    if (!field.empty() && field[0] == '+')
+        field.remove_prefix(1);
+    double value = 0.;
+    std::from_chars(field.data(), field.data() + field.size(), value);
+    return value;
+}
+
+uint32_t input_preworker::parsed_file::intern(std::string_view string) {
+    auto string_it = string_ids.find(string);
+    if (string_it != string_ids.end())
+        return string_it->second;
+    strings.emplace_back(string);
+    return string_ids.emplace(strings.back(), static_cast<uint32_t>(strings.size() - 1)).first->second;
+}
+
+void input_preworker::tokenize_substitution(std::string_view line, std::vector<std::string_view> &fields,
+                                            parsed_file &file) {
+    split_line(line, Element_line_separators, fields);
+    line_record call_record;
+    call_record.kind = line_kind::substitution;
+    call_record.name = file.intern(get_field(fields, 0));
+    for (size_t field_index = 1; field_index < fields.size(); field_index++) {
+        const int vertex = get_integer(fields[field_index]);
         if (!vertex)
             break;
-        vertex_number = std::max(vertex_number, vertex);
-        call_tokens.push_back(std::to_string(vertex));
+        file.max_vertex = std::max(file.max_vertex, vertex);
+        call_record.parameter_vertices.push_back(vertex);
     }
-    tokens.push_back(call_tokens);
+    file.lines.push_back(std::move(call_record));
 }
 
-void input_preworker::tokenize_edge(const Scanner &scanner) {
-    std::stringstream edge_line_ = simplify_edge_line(scanner);
-    std::vector<std::string> edge_tokens(5);
-    int incoming_vertex, outcoming_vertex;
-    edge_line_ >> outcoming_vertex >> std::ws >> incoming_vertex >> std::ws;
-    vertex_number = std::max(vertex_number, outcoming_vertex);
-    vertex_number = std::max(vertex_number, incoming_vertex);
-    edge_tokens[0] = std::to_string(outcoming_vertex);
-    edge_tokens[1] = std::to_string(incoming_vertex);
-    tokenize_edge_attributes(edge_line_, edge_tokens, 0);
+void input_preworker::tokenize_edge(std::string_view line, std::vector<std::string_view> &fields, parsed_file &file) {
+    const size_t comma_position = std::min(line.find(','), line.size());
+    split_line(line.substr(0, comma_position), Edge_vertex_separators, fields);
+    line_record edge_record;
+    edge_record.kind = line_kind::edge;
+    edge_record.vertices[0] = get_integer(get_field(fields, 0));
+    edge_record.vertices[1] = get_integer(get_field(fields, 1));
+    file.max_vertex = std::max(file.max_vertex, edge_record.vertices[0]);
+    file.max_vertex = std::max(file.max_vertex, edge_record.vertices[1]);
+    tokenize_edge_attributes(line.substr(comma_position), edge_record, fields, file);
 }
 
-void input_preworker::tokenize_edge_attributes(std::stringstream &edge_line_, std::vector<std::string> &edge_tokens,
-                                               int shift) {
-    edge_line_ >> edge_tokens[shift + 2] >> std::ws >> edge_tokens[shift + 3] >> std::ws >> edge_tokens[shift + 4] >>
-               std::ws;
-    if (!edge_line_.eof()) {
-        edge_tokens.resize(shift + 7);
-        edge_line_ >> edge_tokens[shift + 5] >> std::ws >> edge_tokens[shift + 6];
-    }
-    tokens.push_back(edge_tokens);
+void input_preworker::tokenize_element_edge(std::string_view line, std::vector<std::string_view> &fields,
+                                            parsed_file &file) {
+    const size_t comma_position = std::min(line.find(','), line.size());
+    split_line(line.substr(0, comma_position), Edge_vertex_separators, fields);
+    line_record element_record;
+    element_record.kind = line_kind::element_edge;
+    element_record.variables[0] = file.intern(get_field(fields, 0));
+    element_record.variables[1] = file.intern(get_field(fields, 1));
+    tokenize_edge_attributes(line.substr(comma_position), element_record, fields, file);
 }
 
-void input_preworker::tokenize_element_edge(const Scanner &scanner) {
-    std::stringstream element_line_ = simplify_edge_line(scanner);
-    std::vector<std::string> element_tokens(6);
-    element_line_ >> std::ws >> element_tokens[1] >> std::ws  >> element_tokens[2] >> std::ws;
-    tokenize_edge_attributes(element_line_, element_tokens, 1);
+void input_preworker::tokenize_edge_attributes(std::string_view attributes, line_record &record,
+                                               std::vector<std::string_view> &fields, parsed_file &file) {
+    split_line(attributes, Edge_attribute_separators, fields);
+    // Resistance, capacitance and inductance are followed by optional voltage and phase
+    const size_t attribute_number = fields.size() > 3 ? 5 : 3;
+    record.attributes_offset = file.attribute_text.size();
+    for (size_t attribute_index = 0; attribute_index < attribute_number; attribute_index++) {
+        if (attribute_index)
+            file.attribute_text += ' ';
+        file.attribute_text += get_field(fields, attribute_index);
+    }
+    record.attributes_size = file.attribute_text.size() - record.attributes_offset;
+    record.resistance = get_value(get_field(fields, 0));
+    record.resistance -= std::complex(0., get_value(get_field(fields, 1)));
+    record.resistance += std::complex(0., get_value(get_field(fields, 2)));
+    if (attribute_number == 5) {
+        double phase = -get_value(get_field(fields, 4)) / 180 * M_PI;
+        record.emf = std::polar(get_value(get_field(fields, 3)), phase);
+    }
+    file.lines.push_back(std::move(record));
 }
 
-std::stringstream input_preworker::simplify_edge_line(const Scanner &scanner) const {
-    std::string element_line(scanner.YYText());
-    auto comma_it = element_line.find(',');
-    std::replace(element_line.begin(), element_line.begin() + comma_it, '-', ' ');
-    std::replace(element_line.begin(), element_line.end(), ',', ' ');
-    std::replace(element_line.begin(), element_line.end(), ';', ' ');
-    std::stringstream element_line_(element_line);
-    return element_line_;
+void input_preworker::tokenize_two_token_line(std::string_view line, line_kind kind,
+                                              std::vector<std::string_view> &fields, parsed_file &file) {
+    split_line(line, Whitespaces, fields);
+    line_record two_token_record;
+    two_token_record.kind = kind;
+    two_token_record.name = file.intern(get_field(fields, 1));
+    file.lines.push_back(std::move(two_token_record));
 }
 
-void input_preworker::tokenize_internal(const Scanner &scanner) {
-    tokenize_two_token_line(scanner, 1);
+void input_preworker::tokenize_define(std::string_view line, std::vector<std::string_view> &fields,
+                                      parsed_file &file) {
+    split_line(line, Element_line_separators, fields);
+    line_record define_record;
+    define_record.kind = line_kind::define;
+    define_record.name = file.intern(get_field(fields, 1));
+    for (size_t field_index = 2; field_index < fields.size(); field_index++) {
+        define_record.parameters.push_back(file.intern(fields[field_index]));
+    }
+    file.lines.push_back(std::move(define_record));
 }
 
-void input_preworker::tokenize_two_token_line(const Scanner &scanner, int shift) {
-    std::stringstream internal_line(scanner.YYText());
-    std::vector<std::string> internal_tokens(shift + 2);
-    internal_line >> std::ws >> internal_tokens[shift] >> std::ws >> internal_tokens[shift + 1];
-    tokens.push_back(internal_tokens);
+input_preworker::token_lines input_preworker::get_tokens() const {
+    token_lines tokens;
+    for (const auto &record : lines) {
+        tokens.push_back(get_token_line(*source, record));
+    }
+    return tokens;
 }
 
-void input_preworker::tokenize_define(const Scanner &scanner) {
-    std::stringstream define_line_ = simplify_element_line(scanner);
-    std::vector<std::string> define_tokens(2);
-    define_line_ >> define_tokens[0] >> std::ws >> define_tokens[1] >> std::ws;
-    while (true) {
-        std::string variable;
-        define_line_ >> variable >> std::ws;
-        if (variable.empty())
+std::vector<std::string> input_preworker::get_token_line(const parsed_file &file, const line_record &record) {
+    std::vector<std::string> token_line;
+    switch (record.kind) {
+        case line_kind::empty:
+            token_line.emplace_back();
+            break;
+        case line_kind::include:
+            token_line = {"include", file.strings[record.name]};
+            break;
+        case line_kind::define:
+            token_line = {"define", file.strings[record.name]};
+            for (const auto parameter : record.parameters)
+                token_line.push_back(file.strings[parameter]);
+            break;
+        case line_kind::internal:
+            token_line = {"", "internal", file.strings[record.name]};
+            break;
+        case line_kind::element_edge:
+            token_line = {"", file.strings[record.variables[0]], file.strings[record.variables[1]]};
+            break;
+        case line_kind::edge:
+            token_line = {std::to_string(record.vertices[0]), std::to_string(record.vertices[1])};
+            break;
+        case line_kind::substitution:
+            token_line = {file.strings[record.name]};
+            for (const auto vertex : record.parameter_vertices)
+                token_line.push_back(std::to_string(vertex));
             break;
-        define_tokens.push_back(variable);
     }
-    tokens.push_back(define_tokens);
+    std::vector<std::string_view> attributes;
+    split_line(file.get_attributes(record), Whitespaces, attributes);
+    token_line.insert(token_line.end(), attributes.begin(), attributes.end());
+    return token_line;
 }
 
-std::stringstream input_preworker::simplify_element_line(const Scanner &scanner) const {
-    std::string define_line(scanner.YYText());
-    std::replace(define_line.begin(), define_line.end(), '(', ' ');
-    std::replace(define_line.begin(), define_line.end(), ')', ' ');
-    std::replace(define_line.begin(), define_line.end(), ',', ' ');
-    std::stringstream define_line_(define_line);
-    return define_line_;
+bool input_preworker::is_element_body_line(const line_record &record) {
+    return record.kind == line_kind::empty || record.kind == line_kind::internal ||
+           record.kind == line_kind::element_edge;
 }
 
-void input_preworker::tokenize_include(const Scanner &scanner) {
-    tokenize_two_token_line(scanner, 0);
+void input_preworker::perform_prework() {
+    for (const auto &record : lines) {
+        if (record.kind == line_kind::include)
+            context->loader.load(file_path + source->strings[record.name]);
+    }
+    for (line_index = 0; line_index < lines.size(); line_index++) {
+        const auto &record = lines[line_index];
+        size_t end_line = line_index;
+        if (record.kind == line_kind::define) {
+            line_index = register_element(line_index) - 1;
+        } else if (record.kind == line_kind::include) {
+            manage_include(record);
+        } else if (!is_text_output && (end_line = expand_lines(line_index)) > line_index) {
+            line_index = end_line - 1;
+        } else if (record.kind == line_kind::empty) {
+            continue;
+        } else if (record.kind == line_kind::substitution) {
+            substitute_element(record);
+        } else if (record.kind == line_kind::edge) {
+            add_edge(record);
+        } else {
+            print_message_prefix();
+            std::cout << "Unexpected line outside of element definition" << std::endl;
+            throw UnexpectedTokenException();
+        }
+    }
 }
 
-void input_preworker::perform_prework() {
-    for (line_index = 0; line_index < tokens.size(); line_index++) {
-        auto &token_line = tokens[line_index];
-        while (token_line[0] == "define") {
-            create_element();
-            if (line_index == tokens.size())
-                return;
+size_t input_preworker::expand_lines(size_t first_line) {
+    std::vector<line_expansion> expansions;
+    size_t edge_number = edges.size();
+    graph::vertex vertex_offset = vertex_number;
+    for (size_t line = first_line; line < lines.size(); line++) {
+        const auto &record = lines[line];
+        if (record.kind != line_kind::empty && record.kind != line_kind::edge &&
+            record.kind != line_kind::substitution)
+            break;
+        line_expansion expansion{nullptr, edge_number, vertex_offset};
+        if (record.kind == line_kind::edge) {
+            edge_number++;
+        } else if (record.kind == line_kind::substitution) {
+            auto element_it = context->elements.find(source->strings[record.name]);
+            // Invalid substitutions and first substitutions of an element, which compile its definition,
+            // are left to the sequential expansion to report errors in order
+            if (element_it == context->elements.end() ||
+                element_it->second.parameters.size() != record.parameter_vertices.size())
+                break;
+            const element *element_ = &element_it->second;
+            expansion.element_ = element_;
+            edge_number += element_->compiled_edges.size();
+            vertex_offset += element_->internal_variables.size();
+        }
+        expansions.push_back(expansion);
+    }
+    if (expansions.empty())
+        return first_line;
+
+    edges.resize(edge_number);
+    const size_t chunk_number = expansions.size() < Parallel_expansion_min_line_number ? 1 : thread_number;
+    std::vector<size_t> chunk_failures(chunk_number);
+    if (chunk_number == 1) {
+        chunk_failures[0] = expand_line_range(first_line, expansions, 0, expansions.size());
+    } else {
+        if (!pool)
+            pool = std::make_unique<thread_pool>(thread_number);
+        std::vector<std::future<void>> chunk_results;
+        for (size_t chunk = 0; chunk < chunk_number; chunk++) {
+            chunk_results.push_back(pool->submit([&, chunk] {
+                const size_t begin = expansions.size() * chunk / chunk_number;
+                const size_t end = expansions.size() * (chunk + 1) / chunk_number;
+                chunk_failures[chunk] = expand_line_range(first_line, expansions, begin, end);
+            }));
         }
-        if (token_line[0] == "include") {
-            manage_include(token_line);
-        } else if (token_line.size() == 1 && token_line[0].empty()){
+        for (auto &chunk_result : chunk_results) {
+            chunk_result.get();
+        }
+    }
+
+    for (size_t chunk = 0; chunk < chunk_number; chunk++) {
+        const size_t end = expansions.size() * (chunk + 1) / chunk_number;
+        if (chunk_failures[chunk] == end)
             continue;
-        } else if (!std::isdigit(token_line[0][0])) {
-            substitute_element(token_line);
-        } else {
-            add_edge(token_line);
+        // The failed line is expanded again to report the error in order
+        const auto &expansion = expansions[chunk_failures[chunk]];
+        edges.resize(expansion.edge_offset);
+        vertex_number = static_cast<int>(expansion.vertex_offset);
+        line_index = first_line + chunk_failures[chunk];
+        if (expansion.element_)
+            substitute_element(lines[line_index]);
+        else
+            add_edge(lines[line_index]);
+        return line_index + 1;
+    }
+    vertex_number = static_cast<int>(vertex_offset);
+    return first_line + expansions.size();
+}
+
+size_t input_preworker::expand_line_range(size_t first_line, const std::vector<line_expansion> &expansions,
+                                          size_t begin, size_t end) {
+    std::vector<graph::vertex> slots;
+    for (size_t expansion_index = begin; expansion_index < end; expansion_index++) {
+        const auto &record = lines[first_line + expansion_index];
+        const auto &expansion = expansions[expansion_index];
+        if (expansion.element_) {
+            const auto &element_ = *expansion.element_;
+            slots.resize(element_.parameters.size() + element_.internal_variables.size());
+            for (size_t parameter_index = 0; parameter_index < element_.parameters.size(); parameter_index++) {
+                if (!to_vertex(record.parameter_vertices[parameter_index], slots[parameter_index]))
+                    return expansion_index;
+            }
+            for (size_t internal_index = 0; internal_index < element_.internal_variables.size(); internal_index++) {
+                slots[element_.parameters.size() + internal_index] = expansion.vertex_offset + internal_index + 1;
+            }
+            auto edge_it = edges.begin() + expansion.edge_offset;
+            for (const auto &element_edge : element_.compiled_edges) {
+                *edge_it++ = {slots[element_edge.incoming_slot], slots[element_edge.outcoming_slot],
+                              element_edge.resistance, element_edge.emf};
+            }
+        } else if (record.kind == line_kind::edge) {
+            edges[expansion.edge_offset] = {static_cast<graph::vertex>(record.vertices[1]),
+                                            static_cast<graph::vertex>(record.vertices[0]),
+                                            record.resistance, record.emf};
         }
     }
+    return end;
 }
 
-void input_preworker::add_edge(std::vector<std::string> &token_line) {
-    for (auto& token : token_line)
-        output << token << ' ';
-    output << '\n';
+void input_preworker::add_edge(const line_record &record) {
+    // Edge vertices are scanned without sign, so they are never negative
+    edges.push_back({static_cast<graph::vertex>(record.vertices[1]), static_cast<graph::vertex>(record.vertices[0]),
+                     record.resistance, record.emf});
+    if (!is_text_output)
+        return;
+    output << record.vertices[0] << ' ' << record.vertices[1] << ' ' << source->get_attributes(record) << " \n";
 }
 
-void input_preworker::substitute_element(const std::vector<std::string> &token_line) {
-    std::string element_name = token_line[0];
-    check_element_existance(element_name);
-    auto &element_ = elements[element_name];
-    std::map<std::string, std::string> parameter_value_mapping = map_parameters_values(token_line, element_);
-    update_output_with_element_edges(element_, parameter_value_mapping);
+bool input_preworker::to_vertex(int vertex_id, graph::vertex &vertex) {
+    if (vertex_id < 0)
+        return false;
+    vertex = static_cast<graph::vertex>(vertex_id);
+    return true;
 }
 
-void input_preworker::check_element_existance(const std::string &element_name) const {
-    if (!elements.count(element_name)) {
+graph::vertex input_preworker::get_vertex(int vertex_id) const {
+    graph::vertex vertex = 0;
+    if (!to_vertex(vertex_id, vertex)) {
+        print_message_prefix();
+        std::cout << "Invalid vertex " << vertex_id << std::endl;
+        throw UnexpectedTokenException();
+    }
+    return vertex;
+}
+
+void input_preworker::substitute_element(const line_record &record) {
+    const std::string &element_name = source->strings[record.name];
+    const element *element_ptr = find_element(element_name);
+    if (!element_ptr) {
         print_message_prefix();
         std::cout << "Unknown element " << element_name << std::endl;
         throw UnknownElementException();
     }
+    const auto &element_ = *element_ptr;
+    fill_slot_vertices(record, element_);
+    for (const auto &element_edge : element_.compiled_edges) {
+        edges.push_back({slot_vertices[element_edge.incoming_slot], slot_vertices[element_edge.outcoming_slot],
+                         element_edge.resistance, element_edge.emf});
+    }
+    if (is_text_output)
+        update_output_with_element_edges(element_);
 }
 
-void input_preworker::print_message_prefix() const { std::cout << file_name_ << " line " << line_index + 1 << ": "; }
+void input_preworker::print_message_prefix(const std::string &file, size_t line) {
+    std::cout << file << " line " << line + 1 << ": ";
+}
 
-void input_preworker::update_output_with_element_edges(input_preworker::element &element_,
-                                                       const std::map<std::string, std::string> &parameter_value_mapping) {
-    for (auto &element_edges: element_.edges) {
-        output << parameter_value_mapping.at(element_edges[1]) << " " <<
-               parameter_value_mapping.at(element_edges[2]);
+void input_preworker::update_output_with_element_edges(const element &element_) {
+    for (size_t edge_index = 0; edge_index < element_.edges.size(); edge_index++) {
+        const auto &element_edges = element_.edges[edge_index];
+        const auto &element_edge = element_.compiled_edges[edge_index];
+        output << slot_vertices[element_edge.outcoming_slot] << " " << slot_vertices[element_edge.incoming_slot];
         for (size_t edge_attribute = 3; edge_attribute < element_edges.size(); edge_attribute++)
             output << ' ' << element_edges[edge_attribute];
         output << " \n";
     }
 }
 
-std::map<std::string, std::string>
-input_preworker::map_parameters_values(const std::vector<std::string> &token_line, input_preworker::element &element_) {
-    std::vector<std::string> element_values;
-    for (size_t value_index = 1; value_index < token_line.size(); value_index++) {
-        element_values.push_back(token_line[value_index]);
-    }
-    check_parameters_number(element_, element_values);
-    std::map<std::string, std::string> parameter_value_mapping;
-    for (size_t value_index = 0; value_index < element_values.size(); value_index++) {
-        parameter_value_mapping[element_.parameters[value_index]] = element_values[value_index];
+void input_preworker::fill_slot_vertices(const line_record &record, const element &element_) {
+    check_parameters_number(element_, record.parameter_vertices.size());
+    slot_vertices.resize(element_.parameters.size() + element_.internal_variables.size());
+    for (size_t parameter_index = 0; parameter_index < element_.parameters.size(); parameter_index++) {
+        slot_vertices[parameter_index] = get_vertex(record.parameter_vertices[parameter_index]);
     }
-    for (auto &internal_name: element_.internal_variables) {
-        parameter_value_mapping[internal_name] = std::to_string(++vertex_number);
-        print_message_prefix();
-        std::cout << "internal " << internal_name << " was enumerated with " << vertex_number << std::endl;
+    for (size_t internal_index = 0; internal_index < element_.internal_variables.size(); internal_index++) {
+        slot_vertices[element_.parameters.size() + internal_index] = ++vertex_number;
+        if (is_text_output) {
+            print_message_prefix();
+            std::cout << "internal " << element_.internal_variables[internal_index] << " was enumerated with " <<
+                      vertex_number << std::endl;
+        }
     }
-    return parameter_value_mapping;
 }
 
 void input_preworker::check_parameters_number(const input_preworker::element &element_,
-                                              const std::vector<std::string> &element_values) const {
-    if (element_values.size() != element_.parameters.size()) {
+                                              size_t value_number) const {
+    if (value_number != element_.parameters.size()) {
         print_message_prefix();
         std::cout << element_.name << " requires " << element_.parameters.size() << " parameters, but " <<
-        element_values.size() << " was given" << std::endl;
+        value_number << " was given" << std::endl;
         throw InvalidParameterNumberException();
     }
 }
 
-void input_preworker::manage_include(const std::vector<std::string> &token_line) {
-    std::string file_name = file_path + token_line[1];
-    std::ifstream file_;
-    file_.open(file_name);
-    if (!file_.is_open()) {
+void input_preworker::manage_include(const line_record &record) {
+    const std::string &include_name = source->strings[record.name];
+    std::string file_name = file_path + include_name;
+    std::shared_ptr<const parsed_file> file;
+    try {
+        file = context->loader.load(file_name).get();
+    } catch (const element_library::InvalidLibraryException&) {
+        print_message_prefix();
+        std::cout << "File " << include_name << " is not a valid element library" << std::endl;
+        throw;
+    }
+    if (!file->is_open) {
         print_message_prefix();
-        std::cout << "File " << token_line[1] << " was not opened" << std::endl;
+        std::cout << "File " << include_name << " was not opened" << std::endl;
         throw FileOpenException();
     }
-    input_preworker file_preworker(file_, file_name, vertex_number);
-    file_.close();
+    if (file->library) {
+        const auto &libraries = context->libraries;
+        if (std::find(libraries.begin(), libraries.end(), file->library) != libraries.end())
+            return;
+        for (const auto &name : file->library->get_element_names()) {
+            check_element_redefinition(name);
+        }
+        context->libraries.push_back(file->library);
+        return;
+    }
+    if (!file->invalid_line.empty()) {
+        std::cout << file->invalid_line << std::endl;
+        throw UnexpectedTokenException();
+    }
+    if (!context->loader.enter_file(file_name))
+        return;
+    input_preworker file_preworker(file, vertex_number, is_text_output, thread_number, context);
     file_preworker.perform_prework();
+    context->loader.leave_file(file_name);
     output << file_preworker.get_output();
-    auto &file_elements = file_preworker.get_elements();
-    for (auto& [name, element] : file_elements) {
-        check_element_redefinition(name);
-    }
-    elements.insert(file_elements.begin(), file_elements.end());
+    edges.insert(edges.end(), file_preworker.edges.begin(), file_preworker.edges.end());
     vertex_number = std::max(vertex_number, file_preworker.vertex_number);
 }
 
-void input_preworker::check_element_redefinition(std::string name) {
-    if (elements.count(name)) {
+void input_preworker::check_element_redefinition(const std::string &name) const {
+    const auto &libraries = context->libraries;
+    if (context->element_sources.count(name) || context->elements.count(name) ||
+        std::any_of(libraries.begin(), libraries.end(), [&name](auto &library) { return library->contains(name); })) {
         print_message_prefix();
         std::cout << "Multiple definition of element " << name << std::endl;
         throw MultipleDefinitionException();
     }
 }
 
-void input_preworker::create_element() {
-    auto &token_line = tokens[line_index];
+size_t input_preworker::register_element(size_t define_line) {
+    const std::string &name = source->strings[lines[define_line].name];
+    auto source_it = context->element_sources.find(name);
+    // A file included more than once registers its definitions on the first include only
+    if (source_it == context->element_sources.end() || source_it->second.file != source ||
+        source_it->second.line != define_line) {
+        check_element_redefinition(name);
+        context->element_sources[name] = {source, define_line};
+    }
+    // Definitions of the main input are checked at once, included ones when they are used
+    if (is_main_input)
+        find_element(name);
+    size_t line = define_line + 1;
+    while (line < lines.size() && is_element_body_line(lines[line]))
+        line++;
+    return line;
+}
+
+const input_preworker::element* input_preworker::find_element(const std::string &element_name) {
+    auto element_it = context->elements.find(element_name);
+    if (element_it != context->elements.end())
+        return &element_it->second;
+    auto source_it = context->element_sources.find(element_name);
+    if (source_it != context->element_sources.end()) {
+        const auto &[file, define_line] = source_it->second;
+        return &context->elements.emplace(element_name, create_element(*file, define_line)).first->second;
+    }
+    // Names of included libraries are checked for redefinitions on include
     element element_;
-    element_.name = token_line[1];
-    check_element_redefinition(element_.name);
-    for (size_t parameter_index = 2; parameter_index < token_line.size(); parameter_index++) {
-        element_.parameters.push_back(token_line[parameter_index]);
-        element_.variables.insert(token_line[parameter_index]);
-    }
-    if (line_index == tokens.size() - 1) {
-        line_index++;
-        elements[element_.name] = element_;
-        return;
+    for (const auto &library : context->libraries) {
+        if (library->find_element(element_name, element_))
+            return &context->elements.emplace(element_name, std::move(element_)).first->second;
     }
-    token_line = tokens[++line_index];
-    while (token_line[0].empty()) {
-        if (token_line.size() == 1) {
-            if (line_index == tokens.size() - 1) {
-                line_index++;
-                elements[element_.name] = element_;
-                return;
-            }
-            token_line = tokens[++line_index];
-            continue;
+    return nullptr;
+}
+
+const std::map<std::string, input_preworker::element>& input_preworker::compile_elements() {
+    for (const auto &[name, source_] : context->element_sources) {
+        find_element(name);
+    }
+    for (const auto &library : context->libraries) {
+        for (const auto &name : library->get_element_names()) {
+            find_element(name);
         }
-        if (token_line[1] == "internal") {
-            element_.internal_variables.push_back(token_line[2]);
-            element_.variables.insert(token_line[2]);
-        } else {
-            check_parameter_defined(token_line, element_);
-            element_.edges.push_back(token_line);
+    }
+    return context->elements;
+}
+
+input_preworker::element input_preworker::create_element(const parsed_file &file, size_t define_line) {
+    const auto &define_record = file.lines[define_line];
+    element element_;
+    element_.name = file.strings[define_record.name];
+    std::unordered_map<uint32_t, size_t> variable_slots;
+    for (const auto parameter : define_record.parameters) {
+        variable_slots[parameter] = element_.parameters.size();
+        element_.parameters.push_back(file.strings[parameter]);
+        element_.variables.insert(file.strings[parameter]);
+    }
+    for (size_t line = define_line + 1; line < file.lines.size() && is_element_body_line(file.lines[line]); line++) {
+        const auto &record = file.lines[line];
+        if (record.kind == line_kind::internal) {
+            variable_slots[record.name] = element_.parameters.size() + element_.internal_variables.size();
+            element_.internal_variables.push_back(file.strings[record.name]);
+            element_.variables.insert(file.strings[record.name]);
+        } else if (record.kind == line_kind::element_edge) {
+            check_parameter_defined(file, record, element_, line);
+            element_.edges.push_back(get_token_line(file, record));
+            element_.compiled_edges.push_back({variable_slots.at(record.variables[0]),
+                                               variable_slots.at(record.variables[1]),
+                                               record.resistance, record.emf});
         }
-        if (line_index == tokens.size() - 1) {
-            elements[element_.name] = element_;
-            line_index++;
-            return;
+    }
+    return element_;
+}
+
+void input_preworker::check_parameter_defined(const parsed_file &file, const line_record &record,
+                                              const input_preworker::element &element_, size_t line_number) {
+    for (const auto variable : record.variables) {
+        if (!element_.variables.count(file.strings[variable])) {
+            print_message_prefix(file.file_name, line_number);
+            std::cout << "Parameter " << file.strings[variable] << " in element " << element_.name << "is undefined" <<
+                      std::endl;
+            throw UndefinedVariableException();
         }
-        token_line = tokens[++line_index];
     }
-    elements[element_.name] = element_;
 }
 
-void input_preworker::check_parameter_defined(const std::vector<std::string> &token_line,
-                                              const input_preworker::element &element_) const {
-    if (!element_.variables.count(token_line[1])) {
-        print_message_prefix();
-        std::cout << "Parameter " << token_line[1] << " in element " << element_.name << "is undefined" << std::endl;
-        throw UndefinedVariableException();
+input_preworker::include_loader::include_loader(size_t thread_number) {
+    if (thread_number > 1)
+        pool = std::make_unique<thread_pool>(thread_number);
+}
+
+input_preworker::include_loader::loaded_file input_preworker::include_loader::load(const std::string &file_name) {
+    auto file = std::make_shared<std::promise<std::shared_ptr<const parsed_file>>>();
+    loaded_file result;
+    {
+        std::lock_guard<std::mutex> lock(files_mutex);
+        auto [file_it, is_new_file] = files.emplace(get_file_key(file_name), file->get_future().share());
+        result = file_it->second;
+        if (!is_new_file)
+            return result;
     }
-    if (!element_.variables.count(token_line[2])) {
-        print_message_prefix();
-        std::cout << "Parameter " << token_line[2] << " in element " << element_.name << "is undefined" << std::endl;
-        throw UndefinedVariableException();
+    auto task = [this, file_name, file] {
+        std::shared_ptr<const parsed_file> parsed_file_;
+        try {
+            parsed_file_ = read_file(file_name);
+        } catch (...) {
+            file->set_exception(std::current_exception());
+            return;
+        }
+        file->set_value(parsed_file_);
+        const std::string path = file_name.substr(0, file_name.find_last_of('/') + 1);
+        for (const auto &record : parsed_file_->lines) {
+            if (record.kind == line_kind::include)
+                load(path + parsed_file_->strings[record.name]);
+        }
+    };
+    if (pool)
+        pool->submit(task);
+    else
+        task();
+    return result;
+}
+
+bool input_preworker::include_loader::enter_file(const std::string &file_name) {
+    return active_files.insert(get_canonical_path(file_name)).second;
+}
+
+void input_preworker::include_loader::leave_file(const std::string &file_name) {
+    active_files.erase(get_canonical_path(file_name));
+}
+
+std::shared_ptr<const input_preworker::parsed_file> input_preworker::include_loader::read_file(
+        const std::string &file_name) {
+    auto file = std::make_shared<parsed_file>();
+    file->file_name = file_name;
+    std::ifstream input(file_name, std::ios::binary);
+    if (!input.is_open()) {
+        file->is_open = false;
+        return file;
+    }
+    if (element_library::is_library(input)) {
+        file->library = std::make_shared<element_library>(file_name);
+        return file;
     }
+    tokenize(input, *file);
+    return file;
+}
+
+std::string input_preworker::include_loader::get_canonical_path(const std::string &file_name) {
+    std::error_code error;
+    auto path = std::filesystem::canonical(file_name, error);
+    return error ? file_name : path.string();
+}
+
+std::string input_preworker::include_loader::get_file_key(const std::string &file_name) {
+    std::error_code error;
+    const auto modification_time = std::filesystem::last_write_time(file_name, error);
+    if (error)
+        return file_name;
+    return get_canonical_path(file_name) + '\n' + std::to_string(modification_time.time_since_epoch().count());
 }
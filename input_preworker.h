@@ -5,25 +5,53 @@
 #include <sstream>
 #include <iostream>
 #include <map>
+#include <deque>
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <future>
 #include <set>
+#include <string_view>
+#include <unordered_map>
+#include "input_parser.h"
+#include "thread_pool.h"
 #include "scanner.h"
 
+class element_library;
+
 class input_preworker {
 public:
+    // Vertices of element edges are slots: parameters first, then internal variables
+    struct element_edge {
+        size_t outcoming_slot;
+        size_t incoming_slot;
+        std::complex<double> resistance;
+        std::complex<double> emf;
+    };
+
     struct element {
         std::string name;
         std::vector<std::string> parameters;
         std::set<std::string> variables;
         std::vector<std::string> internal_variables;
         std::vector<std::vector<std::string>> edges;
+        std::vector<element_edge> compiled_edges;
     };
 
-    explicit input_preworker(std::istream& input, const std::string& file, int max_vertex);
+    typedef std::vector<std::vector<std::string>> token_lines;
+
+    // The text output is a debug dump of the edges, the circuit is built from the edge records
+    explicit input_preworker(std::istream& input, const std::string& file, int max_vertex,
+                             bool is_text_output_ = true, size_t thread_number_ = 1);
     void perform_prework();
     std::string get_output() const { return output.str(); }
-    auto& get_tokens() const { return tokens; }
-    auto& get_elements() const { return elements; }
+    const std::vector<input_parser::state>& get_edges() const { return edges; }
+    // String form of the scanned lines, built from the line records on every call
+    token_lines get_tokens() const;
+    // Definitions of included files are compiled on their first substitution only
+    const std::map<std::string, element>& get_elements() const { return context->elements; }
+    // Compiles every element defined in the input, in its includes and in included libraries
+    const std::map<std::string, element>& compile_elements();
 
     class UnknownElementException : std::exception {
         const char* what () const throw () { return "Element was not defined"; }
@@ -50,53 +78,163 @@ public:
     };
 
 private:
+    enum class line_kind : uint8_t {empty, include, define, internal, element_edge, edge, substitution};
+
+    // Typed form of a scanned line, names are ids in the string table of the file
+    struct line_record {
+        line_kind kind = line_kind::empty;
+        // Included file, defined or substituted element, or internal variable
+        uint32_t name = 0;
+        int vertices[2] = {};
+        // Variables of an element edge
+        uint32_t variables[2] = {};
+        // Range of the attribute text with the edge attribute tokens kept for the text output
+        size_t attributes_offset = 0;
+        size_t attributes_size = 0;
+        std::complex<double> resistance;
+        std::complex<double> emf;
+        std::vector<uint32_t> parameters;
+        std::vector<int> parameter_vertices;
+    };
+
+    struct parsed_file {
+        std::string file_name;
+        std::vector<line_record> lines;
+        // The deque keeps the views used as keys of the string ids valid
+        std::deque<std::string> strings;
+        std::unordered_map<std::string_view, uint32_t> string_ids;
+        std::string attribute_text;
+        int max_vertex = 0;
+        bool is_open = true;
+        std::string invalid_line;
+        std::shared_ptr<const element_library> library;
+
+        uint32_t intern(std::string_view string);
+        std::string_view get_attributes(const line_record &record) const {
+            return std::string_view(attribute_text).substr(record.attributes_offset, record.attributes_size);
+        }
+    };
+
+    struct element_source {
+        std::shared_ptr<const parsed_file> file;
+        size_t line;
+    };
+
+    // Parses every included file once, includes of a loaded file are loaded concurrently
+    class include_loader {
+    public:
+        typedef std::shared_future<std::shared_ptr<const parsed_file>> loaded_file;
+
+        explicit include_loader(size_t thread_number);
+        loaded_file load(const std::string& file_name);
+        // Returns false if the file is already on the include stack, so including it again is a cycle
+        bool enter_file(const std::string& file_name);
+        void leave_file(const std::string& file_name);
+
+    private:
+        std::mutex files_mutex;
+        std::map<std::string, loaded_file> files;
+        std::set<std::string> active_files;
+        std::unique_ptr<thread_pool> pool;
+
+        static std::shared_ptr<const parsed_file> read_file(const std::string& file_name);
+        static std::string get_canonical_path(const std::string& file_name);
+        static std::string get_file_key(const std::string& file_name);
+    };
+
+    // Shared by the main input and all included files
+    struct prework_context {
+        explicit prework_context(size_t thread_number): loader(thread_number) {}
+
+        include_loader loader;
+        std::map<std::string, element_source> element_sources;
+        std::vector<std::shared_ptr<const element_library>> libraries;
+        std::map<std::string, element> elements;
+    };
+
     std::string file_name_;
     std::string file_path;
+    bool is_text_output;
+    size_t thread_number;
+    bool is_main_input;
+    std::shared_ptr<const parsed_file> source;
+    const std::vector<line_record> &lines;
+    std::shared_ptr<prework_context> context;
+    std::unique_ptr<thread_pool> pool;
     std::stringstream output;
-    std::vector<std::vector<std::string>> tokens;
-    std::map<std::string, element> elements;
+    std::vector<input_parser::state> edges;
     int vertex_number = 0;
     size_t line_index = 0;
+    std::vector<graph::vertex> slot_vertices;
+
+    // Edge and internal vertex offsets of a substitution or edge line, known before the expansion
+    struct line_expansion {
+        const element* element_;
+        size_t edge_offset;
+        graph::vertex vertex_offset;
+    };
+
+    input_preworker(std::shared_ptr<const parsed_file> file, int max_vertex, bool is_text_output_,
+                    size_t thread_number_, std::shared_ptr<prework_context> context_);
+
+    size_t expand_lines(size_t first_line);
+    size_t expand_line_range(size_t first_line, const std::vector<line_expansion> &expansions,
+                             size_t begin, size_t end);
+    static bool to_vertex(int vertex_id, graph::vertex &vertex);
+
+    size_t register_element(size_t define_line);
+    const element* find_element(const std::string &element_name);
+    static element create_element(const parsed_file &file, size_t define_line);
 
-    void create_element();
+    void manage_include(const line_record &record);
+    void substitute_element(const line_record &record);
+    void add_edge(const line_record &record);
+    graph::vertex get_vertex(int vertex_id) const;
+    void fill_slot_vertices(const line_record &record, const element &element_);
+    void update_output_with_element_edges(const element &element_);
+    void check_parameters_number(const element &element_, size_t value_number) const;
+    static void check_parameter_defined(const parsed_file &file, const line_record &record, const element &element_,
+                                        size_t line_number);
+    static std::vector<std::string> get_token_line(const parsed_file &file, const line_record &record);
+    static bool is_element_body_line(const line_record &record);
+    void print_message_prefix() const { print_message_prefix(file_name_, line_index); }
+    static void print_message_prefix(const std::string &file, size_t line);
 
-    void manage_include(const std::vector<std::string> &token_line);
-    void substitute_element(const std::vector<std::string> &token_line);
-    void add_edge(std::vector<std::string> &token_line);
-    std::map<std::string, std::string>
-    map_parameters_values(const std::vector<std::string> &token_line, element &element_);
-    void update_output_with_element_edges(element &element_,
-                                     const std::map<std::string, std::string> &parameter_value_mapping);
-    void check_element_existance(const std::string &element_name) const;
-    void check_parameters_number(const element &element_, const std::vector<std::string> &element_values) const;
-    void check_parameter_defined(const std::vector<std::string> &token_line, const element &element_) const;
-    void print_message_prefix() const;
+    static constexpr std::string_view Whitespaces = " \t\n\r\v\f";
+    static constexpr std::string_view Element_line_separators = " \t\n\r\v\f(),";
+    // Minus is a separator before the first comma only, attributes could be negative
+    static constexpr std::string_view Edge_vertex_separators = " \t\n\r\v\f-";
+    static constexpr std::string_view Edge_attribute_separators = " \t\n\r\v\f,;";
+    static constexpr size_t Parallel_expansion_min_line_number = 1024;
 
-    const std::set<std::string> Punctuation{";", ",", "(", ")"};
+    static std::shared_ptr<const parsed_file> read_input(std::istream &input, const std::string &file_name);
 
-    void tokenize(std::istream &input);
+    static void tokenize(std::istream &input, parsed_file &file);
 
-    void tokenize_include(const Scanner &scanner);
+    // Fields are views of the scanned line, the vector is reused for every line
+    static void split_line(std::string_view line, std::string_view separators, std::vector<std::string_view> &fields);
 
-    void tokenize_define(const Scanner &scanner);
+    static std::string_view get_field(const std::vector<std::string_view> &fields, size_t field_index);
 
-    void tokenize_internal(const Scanner &scanner);
+    static int get_integer(std::string_view field);
 
-    void tokenize_element_edge(const Scanner &scanner);
+    static double get_value(std::string_view field);
 
-    void tokenize_edge(const Scanner &scanner);
+    static void tokenize_define(std::string_view line, std::vector<std::string_view> &fields, parsed_file &file);
 
-    void tokenize_substitution(const Scanner &scanner);
+    static void tokenize_edge(std::string_view line, std::vector<std::string_view> &fields, parsed_file &file);
 
-    void tokenize_two_token_line(const Scanner &scanner, int shift);
+    static void tokenize_element_edge(std::string_view line, std::vector<std::string_view> &fields, parsed_file &file);
 
-    std::stringstream simplify_element_line(const Scanner &scanner) const;
+    static void tokenize_substitution(std::string_view line, std::vector<std::string_view> &fields, parsed_file &file);
 
-    std::stringstream simplify_edge_line(const Scanner &scanner) const;
+    static void tokenize_two_token_line(std::string_view line, line_kind kind, std::vector<std::string_view> &fields,
+                                        parsed_file &file);
 
-    void tokenize_edge_attributes(std::stringstream &edge_line_, std::vector<std::string> &edge_tokens, int shift);
+    static void tokenize_edge_attributes(std::string_view attributes, line_record &record,
+                                         std::vector<std::string_view> &fields, parsed_file &file);
 
-    void check_element_redefinition(std::string name);
+    void check_element_redefinition(const std::string &name) const;
 };
 
 
@@ -0,0 +1,467 @@
+#ifndef CIRCUITS_ITERATIVE_SOLVER_H
+#define CIRCUITS_ITERATIVE_SOLVER_H
+
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <vector>
+#include <stdexcept>
+#include "sparse_matrix.h"
+
+struct solver_options {
+    enum class method { direct, iterative, multigrid };
+    enum class preconditioner_type { jacobi, incomplete_cholesky, incomplete_lu, algebraic_multigrid };
+
+    method solver = method::direct;
+    preconditioner_type preconditioner = preconditioner_type::incomplete_cholesky;
+    double tolerance = 1e-10;
+    size_t max_iterations = 10000;
+    size_t thread_number = 0;
+};
+
+struct solver_statistics {
+    size_t iterations = 0;
+    double relative_residual = 0.;
+    bool converged = false;
+};
+
+template <typename T>
+T dot_product(const std::vector<T>& left, const std::vector<T>& right) {
+    T result = static_cast<T>(0);
+    for (size_t element = 0; element < left.size(); element++) {
+        result += left[element] * right[element];
+    }
+    return result;
+}
+
+template <typename T>
+T conjugate(const T& value) {
+    return value;
+}
+
+template <typename T>
+std::complex<T> conjugate(const std::complex<T>& value) {
+    return std::conj(value);
+}
+
+template <typename T>
+T hermitian_product(const std::vector<T>& left, const std::vector<T>& right) {
+    T result = static_cast<T>(0);
+    for (size_t element = 0; element < left.size(); element++) {
+        result += conjugate(left[element]) * right[element];
+    }
+    return result;
+}
+
+template <typename T>
+double euclidean_norm(const std::vector<T>& vector_) {
+    double result = 0.;
+    for (const auto& element : vector_) {
+        result += std::norm(element);
+    }
+    return std::sqrt(result);
+}
+
+template <typename T>
+class preconditioner {
+public:
+    virtual ~preconditioner() = default;
+    virtual std::vector<T> apply(const std::vector<T>& residual) const = 0;
+};
+
+template <typename T>
+class jacobi_preconditioner : public preconditioner<T> {
+public:
+    explicit jacobi_preconditioner(const sparse_matrix<T>& matrix_);
+    std::vector<T> apply(const std::vector<T>& residual) const override;
+
+private:
+    std::vector<T> inverse_diagonal;
+};
+
+template <typename T>
+jacobi_preconditioner<T>::jacobi_preconditioner(const sparse_matrix<T>& matrix_):
+    inverse_diagonal(matrix_.get_row_number(), static_cast<T>(1))
+{
+    for (size_t row_ = 0; row_ < matrix_.get_row_number(); row_++) {
+        const T diagonal = matrix_.get_element(row_, row_);
+        if (diagonal != static_cast<T>(0))
+            inverse_diagonal[row_] = static_cast<T>(1) / diagonal;
+    }
+}
+
+template <typename T>
+std::vector<T> jacobi_preconditioner<T>::apply(const std::vector<T>& residual) const {
+    std::vector<T> result(residual.size());
+    for (size_t row_ = 0; row_ < residual.size(); row_++) {
+        result[row_] = inverse_diagonal[row_] * residual[row_];
+    }
+    return result;
+}
+
+template <typename T>
+class incomplete_cholesky_preconditioner : public preconditioner<T> {
+public:
+    typedef typename sparse_matrix<T>::index index;
+
+    explicit incomplete_cholesky_preconditioner(const sparse_matrix<T>& matrix_);
+    std::vector<T> apply(const std::vector<T>& residual) const override;
+
+private:
+    std::vector<index> row_offsets;
+    std::vector<index> col_indices;
+    std::vector<T> values;
+
+    void extract_lower_triangle(const sparse_matrix<T>& matrix_);
+    void decompose();
+    T get_sparse_row_product(index first_row, index second_row, index col_end) const;
+};
+
+template <typename T>
+incomplete_cholesky_preconditioner<T>::incomplete_cholesky_preconditioner(const sparse_matrix<T>& matrix_) {
+    if (matrix_.get_row_number() != matrix_.get_col_number())
+        throw std::runtime_error("Cannot make matrix decomposition");
+    extract_lower_triangle(matrix_);
+    decompose();
+}
+
+template <typename T>
+void incomplete_cholesky_preconditioner<T>::extract_lower_triangle(const sparse_matrix<T>& matrix_) {
+    const auto& matrix_offsets = matrix_.get_row_offsets();
+    const auto& matrix_indices = matrix_.get_col_indices();
+    const auto& matrix_values = matrix_.get_values();
+
+    row_offsets.assign(1, 0);
+    for (size_t row_ = 0; row_ < matrix_.get_row_number(); row_++) {
+        for (index position = matrix_offsets[row_]; position < matrix_offsets[row_ + 1]; position++) {
+            if (matrix_indices[position] >= row_)
+                break;
+            col_indices.push_back(matrix_indices[position]);
+            values.push_back(matrix_values[position]);
+        }
+        col_indices.push_back(static_cast<index>(row_));
+        values.push_back(matrix_.get_element(row_, row_));
+        row_offsets.push_back(static_cast<index>(values.size()));
+    }
+}
+
+template <typename T>
+T incomplete_cholesky_preconditioner<T>::get_sparse_row_product(index first_row, index second_row,
+                                                                index col_end) const {
+    T result = static_cast<T>(0);
+    index first = row_offsets[first_row], second = row_offsets[second_row];
+    while (first < row_offsets[first_row + 1] && second < row_offsets[second_row + 1] &&
+           col_indices[first] < col_end && col_indices[second] < col_end) {
+        if (col_indices[first] < col_indices[second]) {
+            first++;
+        } else if (col_indices[second] < col_indices[first]) {
+            second++;
+        } else {
+            result += values[first++] * values[second++];
+        }
+    }
+    return result;
+}
+
+template <typename T>
+void incomplete_cholesky_preconditioner<T>::decompose() {
+    const size_t size = row_offsets.size() - 1;
+    for (index row_ = 0; row_ < size; row_++) {
+        const index diagonal_position = row_offsets[row_ + 1] - 1;
+        for (index position = row_offsets[row_]; position < diagonal_position; position++) {
+            const index col_ = col_indices[position];
+            values[position] = (values[position] - get_sparse_row_product(row_, col_, col_)) /
+                               values[row_offsets[col_ + 1] - 1];
+        }
+        const T original_diagonal = values[diagonal_position];
+        const T pivot = original_diagonal - get_sparse_row_product(row_, row_, row_);
+        const bool is_breakdown = std::abs(pivot) == 0. || (std::imag(pivot) == 0. && std::real(pivot) < 0.);
+        values[diagonal_position] = std::sqrt(is_breakdown ? original_diagonal : pivot);
+    }
+}
+
+template <typename T>
+std::vector<T> incomplete_cholesky_preconditioner<T>::apply(const std::vector<T>& residual) const {
+    const size_t size = row_offsets.size() - 1;
+    std::vector<T> result(residual);
+    for (size_t row_ = 0; row_ < size; row_++) {
+        const index diagonal_position = row_offsets[row_ + 1] - 1;
+        for (index position = row_offsets[row_]; position < diagonal_position; position++) {
+            result[row_] -= values[position] * result[col_indices[position]];
+        }
+        result[row_] /= values[diagonal_position];
+    }
+    for (size_t row_ = size; row_-- > 0;) {
+        const index diagonal_position = row_offsets[row_ + 1] - 1;
+        result[row_] /= values[diagonal_position];
+        for (index position = row_offsets[row_]; position < diagonal_position; position++) {
+            result[col_indices[position]] -= values[position] * result[row_];
+        }
+    }
+    return result;
+}
+
+template <typename T>
+class incomplete_lu_preconditioner : public preconditioner<T> {
+public:
+    typedef typename sparse_matrix<T>::index index;
+
+    explicit incomplete_lu_preconditioner(const sparse_matrix<T>& matrix_);
+    std::vector<T> apply(const std::vector<T>& residual) const override;
+
+private:
+    std::vector<index> row_offsets;
+    std::vector<index> col_indices;
+    std::vector<T> values;
+    std::vector<index> diagonal_positions;
+
+    void find_diagonal_positions();
+    void decompose();
+};
+
+template <typename T>
+incomplete_lu_preconditioner<T>::incomplete_lu_preconditioner(const sparse_matrix<T>& matrix_):
+    row_offsets(matrix_.get_row_offsets()),
+    col_indices(matrix_.get_col_indices()),
+    values(matrix_.get_values())
+{
+    if (matrix_.get_row_number() != matrix_.get_col_number())
+        throw std::runtime_error("Cannot make matrix decomposition");
+    find_diagonal_positions();
+    decompose();
+}
+
+template <typename T>
+void incomplete_lu_preconditioner<T>::find_diagonal_positions() {
+    const size_t size = row_offsets.size() - 1;
+    diagonal_positions.resize(size);
+    for (size_t row_ = 0; row_ < size; row_++) {
+        auto row_begin = col_indices.begin() + row_offsets[row_];
+        auto row_end = col_indices.begin() + row_offsets[row_ + 1];
+        auto position = std::lower_bound(row_begin, row_end, row_);
+        if (position == row_end || *position != row_)
+            throw std::runtime_error("Incomplete LU requires nonzero diagonal pattern");
+        diagonal_positions[row_] = static_cast<index>(position - col_indices.begin());
+    }
+}
+
+template <typename T>
+void incomplete_lu_preconditioner<T>::decompose() {
+    const size_t size = row_offsets.size() - 1;
+    const index No_position = std::numeric_limits<index>::max();
+    std::vector<index> row_positions(size, No_position);
+    for (size_t row_ = 0; row_ < size; row_++) {
+        for (index position = row_offsets[row_]; position < row_offsets[row_ + 1]; position++) {
+            row_positions[col_indices[position]] = position;
+        }
+        for (index position = row_offsets[row_]; position < diagonal_positions[row_]; position++) {
+            const index pivot_row = col_indices[position];
+            values[position] /= values[diagonal_positions[pivot_row]];
+            const T multiplier = values[position];
+            for (index pivot_position = diagonal_positions[pivot_row] + 1;
+                 pivot_position < row_offsets[pivot_row + 1]; pivot_position++) {
+                const index target = row_positions[col_indices[pivot_position]];
+                if (target != No_position)
+                    values[target] -= multiplier * values[pivot_position];
+            }
+        }
+        if (values[diagonal_positions[row_]] == static_cast<T>(0))
+            values[diagonal_positions[row_]] = static_cast<T>(1);
+        for (index position = row_offsets[row_]; position < row_offsets[row_ + 1]; position++) {
+            row_positions[col_indices[position]] = No_position;
+        }
+    }
+}
+
+template <typename T>
+std::vector<T> incomplete_lu_preconditioner<T>::apply(const std::vector<T>& residual) const {
+    const size_t size = row_offsets.size() - 1;
+    std::vector<T> result(residual);
+    for (size_t row_ = 0; row_ < size; row_++) {
+        for (index position = row_offsets[row_]; position < diagonal_positions[row_]; position++) {
+            result[row_] -= values[position] * result[col_indices[position]];
+        }
+    }
+    for (size_t row_ = size; row_-- > 0;) {
+        for (index position = diagonal_positions[row_] + 1; position < row_offsets[row_ + 1]; position++) {
+            result[row_] -= values[position] * result[col_indices[position]];
+        }
+        result[row_] /= values[diagonal_positions[row_]];
+    }
+    return result;
+}
+
+template <typename T>
+std::unique_ptr<preconditioner<T>> make_preconditioner(const sparse_matrix<T>& matrix_,
+                                                       solver_options::preconditioner_type type) {
+    if (type == solver_options::preconditioner_type::jacobi)
+        return std::make_unique<jacobi_preconditioner<T>>(matrix_);
+    if (type == solver_options::preconditioner_type::incomplete_lu)
+        return std::make_unique<incomplete_lu_preconditioner<T>>(matrix_);
+    return std::make_unique<incomplete_cholesky_preconditioner<T>>(matrix_);
+}
+
+template <typename T>
+class conjugate_gradient {
+public:
+    conjugate_gradient(const sparse_matrix<T>& matrix_, const preconditioner<T>& preconditioner_,
+                       double tolerance_, size_t max_iterations_);
+
+    std::vector<T> solve(const std::vector<T>& right_side);
+    const solver_statistics& get_statistics() const { return statistics; }
+
+private:
+    const sparse_matrix<T>& system_matrix;
+    const preconditioner<T>& system_preconditioner;
+    double tolerance;
+    size_t max_iterations;
+    solver_statistics statistics;
+};
+
+template <typename T>
+conjugate_gradient<T>::conjugate_gradient(const sparse_matrix<T>& matrix_, const preconditioner<T>& preconditioner_,
+                                          double tolerance_, size_t max_iterations_):
+    system_matrix(matrix_),
+    system_preconditioner(preconditioner_),
+    tolerance(tolerance_),
+    max_iterations(max_iterations_) {}
+
+template <typename T>
+std::vector<T> conjugate_gradient<T>::solve(const std::vector<T>& right_side) {
+    if (right_side.size() != system_matrix.get_row_number())
+        throw std::runtime_error("Linear system could not be solved: right side has wrong size");
+
+    statistics = solver_statistics();
+    std::vector<T> solution(right_side.size(), static_cast<T>(0));
+    const double right_side_norm = euclidean_norm(right_side);
+    if (right_side_norm == 0.) {
+        statistics.converged = true;
+        return solution;
+    }
+
+    std::vector<T> residual(right_side);
+    std::vector<T> preconditioned = system_preconditioner.apply(residual);
+    std::vector<T> direction(preconditioned);
+    T residual_product = dot_product(residual, preconditioned);
+    statistics.relative_residual = 1.;
+    while (statistics.iterations < max_iterations && residual_product != static_cast<T>(0)) {
+        const std::vector<T> matrix_direction = system_matrix.multiply(direction);
+        const T curvature = dot_product(direction, matrix_direction);
+        if (curvature == static_cast<T>(0))
+            break;
+        const T step = residual_product / curvature;
+        for (size_t row_ = 0; row_ < solution.size(); row_++) {
+            solution[row_] += step * direction[row_];
+            residual[row_] -= step * matrix_direction[row_];
+        }
+        statistics.iterations++;
+        statistics.relative_residual = euclidean_norm(residual) / right_side_norm;
+        if (statistics.relative_residual <= tolerance) {
+            statistics.converged = true;
+            break;
+        }
+
+        preconditioned = system_preconditioner.apply(residual);
+        const T next_residual_product = dot_product(residual, preconditioned);
+        const T direction_update = next_residual_product / residual_product;
+        residual_product = next_residual_product;
+        for (size_t row_ = 0; row_ < direction.size(); row_++) {
+            direction[row_] = preconditioned[row_] + direction_update * direction[row_];
+        }
+    }
+    return solution;
+}
+
+template <typename T>
+class biconjugate_gradient_stabilized {
+public:
+    biconjugate_gradient_stabilized(const sparse_matrix<T>& matrix_, const preconditioner<T>& preconditioner_,
+                                    double tolerance_, size_t max_iterations_);
+
+    std::vector<T> solve(const std::vector<T>& right_side);
+    const solver_statistics& get_statistics() const { return statistics; }
+
+private:
+    const sparse_matrix<T>& system_matrix;
+    const preconditioner<T>& system_preconditioner;
+    double tolerance;
+    size_t max_iterations;
+    solver_statistics statistics;
+};
+
+template <typename T>
+biconjugate_gradient_stabilized<T>::biconjugate_gradient_stabilized(const sparse_matrix<T>& matrix_,
+                                                                    const preconditioner<T>& preconditioner_,
+                                                                    double tolerance_, size_t max_iterations_):
+    system_matrix(matrix_),
+    system_preconditioner(preconditioner_),
+    tolerance(tolerance_),
+    max_iterations(max_iterations_) {}
+
+template <typename T>
+std::vector<T> biconjugate_gradient_stabilized<T>::solve(const std::vector<T>& right_side) {
+    if (right_side.size() != system_matrix.get_row_number())
+        throw std::runtime_error("Linear system could not be solved: right side has wrong size");
+
+    statistics = solver_statistics();
+    std::vector<T> solution(right_side.size(), static_cast<T>(0));
+    const double right_side_norm = euclidean_norm(right_side);
+    if (right_side_norm == 0.) {
+        statistics.converged = true;
+        return solution;
+    }
+
+    std::vector<T> residual(right_side);
+    const std::vector<T> shadow_residual(right_side);
+    std::vector<T> direction(right_side.size(), static_cast<T>(0));
+    std::vector<T> matrix_direction(right_side.size(), static_cast<T>(0));
+    std::vector<T> intermediate(right_side.size());
+    T residual_product = static_cast<T>(1), step = static_cast<T>(1), stabilizer = static_cast<T>(1);
+    statistics.relative_residual = 1.;
+    while (statistics.iterations < max_iterations) {
+        const T next_residual_product = hermitian_product(shadow_residual, residual);
+        if (next_residual_product == static_cast<T>(0) || stabilizer == static_cast<T>(0))
+            break;
+        const T direction_update = (next_residual_product / residual_product) * (step / stabilizer);
+        residual_product = next_residual_product;
+        for (size_t row_ = 0; row_ < direction.size(); row_++) {
+            direction[row_] = residual[row_] + direction_update * (direction[row_] - stabilizer * matrix_direction[row_]);
+        }
+
+        const std::vector<T> preconditioned_direction = system_preconditioner.apply(direction);
+        matrix_direction = system_matrix.multiply(preconditioned_direction);
+        const T shadow_product = hermitian_product(shadow_residual, matrix_direction);
+        if (shadow_product == static_cast<T>(0))
+            break;
+        step = residual_product / shadow_product;
+        for (size_t row_ = 0; row_ < intermediate.size(); row_++) {
+            intermediate[row_] = residual[row_] - step * matrix_direction[row_];
+            solution[row_] += step * preconditioned_direction[row_];
+        }
+        statistics.iterations++;
+        statistics.relative_residual = euclidean_norm(intermediate) / right_side_norm;
+        if (statistics.relative_residual <= tolerance) {
+            statistics.converged = true;
+            break;
+        }
+
+        const std::vector<T> preconditioned_intermediate = system_preconditioner.apply(intermediate);
+        const std::vector<T> matrix_intermediate = system_matrix.multiply(preconditioned_intermediate);
+        const T intermediate_norm = hermitian_product(matrix_intermediate, matrix_intermediate);
+        if (intermediate_norm == static_cast<T>(0))
+            break;
+        stabilizer = hermitian_product(matrix_intermediate, intermediate) / intermediate_norm;
+        for (size_t row_ = 0; row_ < residual.size(); row_++) {
+            solution[row_] += stabilizer * preconditioned_intermediate[row_];
+            residual[row_] = intermediate[row_] - stabilizer * matrix_intermediate[row_];
+        }
+        statistics.relative_residual = euclidean_norm(residual) / right_side_norm;
+        if (statistics.relative_residual <= tolerance) {
+            statistics.converged = true;
+            break;
+        }
+    }
+    return solution;
+}
+
+#endif //CIRCUITS_ITERATIVE_SOLVER_H
@@ -7,26 +7,20 @@
 #include <numeric>
 #include <tuple>
 #include <complex>
+#include <limits>
+#include <memory>
+#include <new>
+#include <algorithm>
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#endif
+
+template <typename T>
+class lu_factorization;
 
 template <typename T>
 class matrix {
 public:
-    struct row {
-        T* data;
-
-        void allocate_data(const size_t col_number) {
-            data = new T[col_number];
-        }
-        void deallocate_data() {
-            delete [] data;
-        }
-        T& operator[](const size_t col_index) {
-            return data[col_index];
-        }
-        const T& operator[](const size_t col_index) const {
-            return data[col_index];
-        }
-    };
     matrix() = default;
     matrix(size_t row_number, size_t col_number);
     matrix(const matrix& another_matrix);
@@ -35,9 +29,9 @@ public:
     size_t get_row_number() const { return row_number_; }
     size_t get_col_number() const { return col_number_; }
 
-    row& operator[](const size_t row_index) { return data[row_index]; }
+    T* operator[](const size_t row_index) { return data + row_index * col_number_; }
 
-    const row& operator[](const size_t row_index) const { return data[row_index]; }
+    const T* operator[](const size_t row_index) const { return data + row_index * col_number_; }
 
     matrix<T>& operator=(const matrix& another_matrix);
     matrix<T>& operator=(matrix&& another_matrix) noexcept;
@@ -50,13 +44,16 @@ public:
         bool is_multiplication_possible(const matrix<T>& another_matrix) const;
 
     matrix<T> transpose() const;
+    void swap_rows(size_t first_row, size_t second_row);
 
     matrix<T> inverse() const;
         bool is_square() const;
         matrix<T> get_minor(const size_t row_, const size_t col_) const;
 
+    lu_factorization<T> factorize() const;
+    matrix<T> solve(const matrix<T>& right_side) const;
+
     T get_determinant() const;
-        std::pair<matrix<T>, matrix<T>> get_decomposition() const;
 
     void print() const;
     bool is_equal(const matrix<T>& another_matrix) const;
@@ -67,45 +64,61 @@ public:
     };
 
 private:
-    row* data;
+    T* data = nullptr;
     size_t row_number_ = 0;
     size_t col_number_ = 0;
 
-        void free_data();
-
-        T get_inverse_element(const size_t row_, const size_t col_, const matrix<T>& minor) const;
+    static constexpr size_t Cache_line_size = 64;
+    static constexpr size_t Huge_page_size = 2 * 1024 * 1024;
+    static constexpr size_t Transpose_block_size = 32;
 
-        void initialize_lower() const;
-        void fill_decomposition(matrix<T> &lower, matrix<T> &upper) const;
-            void fill_upper_iteration(const matrix<T> &lower, matrix<T> &upper, size_t row_, size_t col_) const;
-            void fill_lower_iteration(matrix<T> &lower, const matrix<T> &upper, size_t row_, size_t col_) const;
+        size_t get_element_number() const { return row_number_ * col_number_; }
+        static size_t get_alignment(size_t element_number);
+        static T* allocate_data(size_t element_number);
+        static void deallocate_data(T* data_, size_t element_number);
+        void free_data();
 
     bool is_equal(T matrix_element, T another_matrix_element) const;
 };
 
+template <typename T>
+size_t matrix<T>::get_alignment(size_t element_number) {
+    return element_number * sizeof(T) >= Huge_page_size ? Huge_page_size : Cache_line_size;
+}
+
+template <typename T>
+T* matrix<T>::allocate_data(size_t element_number) {
+    if (!element_number)
+        return nullptr;
+    const size_t alignment = get_alignment(element_number);
+    auto data_ = static_cast<T*>(::operator new(element_number * sizeof(T), std::align_val_t(alignment)));
+#ifdef MADV_HUGEPAGE
+    if (alignment == Huge_page_size)
+        madvise(data_, element_number * sizeof(T), MADV_HUGEPAGE);
+#endif
+    return data_;
+}
+
+template <typename T>
+void matrix<T>::deallocate_data(T* data_, size_t element_number) {
+    if (!data_)
+        return;
+    std::destroy_n(data_, element_number);
+    ::operator delete(data_, std::align_val_t(get_alignment(element_number)));
+}
+
 template <typename T>
 matrix<T>::matrix(size_t row_number, size_t col_number):
     row_number_(row_number),
     col_number_(col_number)
 {
     try {
-        data = new row[row_number];
+        data = allocate_data(get_element_number());
     } catch (std::bad_alloc&) {
         std::cout << "Matrix constructor failed: not enough memory" << std::endl;
         throw;
     }
-    for (size_t row_ = 0; row_ < row_number; row_++) {
-        try {
-            data[row_].allocate_data(col_number);
-        } catch (std::bad_alloc&) {
-            free_data();
-            std::cout << "Matrix constructor failed: not enough memory" << std::endl;
-            throw;
-        }
-        for (size_t col_ = 0; col_ < col_number_; col_++) {
-            data[row_][col_] = static_cast<T>(0);
-        }
-    }
+    std::uninitialized_fill_n(data, get_element_number(), static_cast<T>(0));
 }
 
 template <typename T>
@@ -114,21 +127,12 @@ matrix<T>::matrix(const matrix<T>& another_matrix):
     col_number_(another_matrix.col_number_)
 {
     try {
-        data = new row[another_matrix.row_number_];
+        data = allocate_data(get_element_number());
     } catch (std::bad_alloc&) {
         std::cout << "Copy constructor failed: not enough memory" << std::endl;
         throw;
     }
-    for (size_t row_ = 0; row_ < row_number_; row_++) {
-        try {
-            data[row_].allocate_data(col_number_);
-        } catch (std::bad_alloc&) {
-            free_data();
-            std::cout << "Copy constructor failed: not enough memory" << std::endl;
-            throw;
-        }
-        std::copy(another_matrix[row_].data, another_matrix[row_].data + col_number_, data[row_].data);
-    }
+    std::uninitialized_copy_n(another_matrix.data, get_element_number(), data);
 }
 
 template <typename T>
@@ -138,15 +142,20 @@ matrix<T>::matrix(matrix&& another_matrix) noexcept:
     col_number_(another_matrix.col_number_)
 {
     another_matrix.data = nullptr;
+    another_matrix.row_number_ = 0;
+    another_matrix.col_number_ = 0;
 }
 
 template <typename T>
 matrix<T>& matrix<T>::operator=(const matrix& another_matrix) {
     if (this == &another_matrix)
         return *this;
-    this->~matrix();
+    if (is_equal_size(another_matrix)) {
+        std::copy_n(another_matrix.data, get_element_number(), data);
+        return *this;
+    }
     try {
-        new(this) matrix(another_matrix);
+        *this = matrix(another_matrix);
     } catch (std::bad_alloc&) {
         std::cout << "Copy assignment failed: not enough memory" << std::endl;
         throw;
@@ -159,10 +168,12 @@ matrix<T>& matrix<T>::operator=(matrix&& another_matrix) noexcept {
     if (this == &another_matrix)
         return *this;
     free_data();
-    row_number_ = std::move(another_matrix.row_number_);
-    col_number_ = std::move(another_matrix.col_number_);
+    row_number_ = another_matrix.row_number_;
+    col_number_ = another_matrix.col_number_;
     data = another_matrix.data;
     another_matrix.data = nullptr;
+    another_matrix.row_number_ = 0;
+    another_matrix.col_number_ = 0;
     return *this;
 }
 
@@ -171,10 +182,8 @@ matrix<T>& matrix<T>::operator+= (const matrix<T>& another_matrix) {
     if (!is_equal_size(another_matrix))
         throw std::runtime_error("Matrices have different size!");
 
-    for (size_t row_ = 0; row_ < row_number_; row_++) {
-        for (size_t col_ = 0; col_ < col_number_; col_++) {
-            data[row_][col_] += another_matrix[row_][col_];
-        }
+    for (size_t element = 0; element < get_element_number(); element++) {
+        data[element] += another_matrix.data[element];
     }
     return *this;
 }
@@ -184,10 +193,8 @@ matrix<T>& matrix<T>::operator-= (const matrix<T>& another_matrix) {
     if (!is_equal_size(another_matrix))
         throw std::runtime_error("Matrices have different size!");
 
-    for (size_t row_ = 0; row_ < row_number_; row_++) {
-        for (size_t col_ = 0; col_ < col_number_; col_++) {
-            data[row_][col_] -= another_matrix[row_][col_];
-        }
+    for (size_t element = 0; element < get_element_number(); element++) {
+        data[element] -= another_matrix.data[element];
     }
     return *this;
 }
@@ -211,10 +218,15 @@ matrix<T>& matrix<T>::operator*= (const matrix<T>& another_matrix) {
 
     auto result = matrix<T>(row_number_, another_matrix.col_number_);
     for (size_t row_ = 0; row_ < result.row_number_; row_++) {
-        for (size_t col_ = 0; col_ < result.col_number_; col_++) {
-            result[row_][col_] = static_cast<T>(0);
-            for (size_t float_index = 0; float_index < col_number_; float_index++) {
-                result[row_][col_] += data[row_][float_index] * another_matrix[float_index][col_];
+        T* result_row = result[row_];
+        const T* left_row = (*this)[row_];
+        for (size_t float_index = 0; float_index < col_number_; float_index++) {
+            const T left_element = left_row[float_index];
+            if (left_element == static_cast<T>(0))
+                continue;
+            const T* right_row = another_matrix[float_index];
+            for (size_t col_ = 0; col_ < result.col_number_; col_++) {
+                result_row[col_] += left_element * right_row[col_];
             }
         }
     }
@@ -236,29 +248,37 @@ matrix<T> operator*(const matrix<T>& left_matrix, const matrix<T>& right_matrix)
 
 template <typename T>
 matrix<T> matrix<T>::transpose() const {
-     matrix<T> result(col_number_, row_number_);
-
-    for (size_t row_ = 0; row_ < row_number_; row_++) {
-        for (size_t col_ = 0; col_ < col_number_; col_++) {
-            result[col_][row_] = data[row_][col_];
+    matrix<T> result(col_number_, row_number_);
+
+    for (size_t row_block = 0; row_block < row_number_; row_block += Transpose_block_size) {
+        const size_t row_end = std::min(row_block + Transpose_block_size, row_number_);
+        for (size_t col_block = 0; col_block < col_number_; col_block += Transpose_block_size) {
+            const size_t col_end = std::min(col_block + Transpose_block_size, col_number_);
+            for (size_t row_ = row_block; row_ < row_end; row_++) {
+                for (size_t col_ = col_block; col_ < col_end; col_++) {
+                    result[col_][row_] = (*this)[row_][col_];
+                }
+            }
         }
     }
 
     return result;
 }
 
+template <typename T>
+void matrix<T>::swap_rows(size_t first_row, size_t second_row) {
+    std::swap_ranges((*this)[first_row], (*this)[first_row] + col_number_, (*this)[second_row]);
+}
+
 template <typename T>
 matrix<T>::~matrix() {
-    if (data)
-        free_data();
+    free_data();
 }
 
 template <typename T>
 void matrix<T>::free_data() {
-    for (size_t row_ = 0; row_ < row_number_; row_++) {
-        data[row_].deallocate_data();
-    }
-    delete [] data;
+    deallocate_data(data, get_element_number());
+    data = nullptr;
 }
 
 template <typename T>
@@ -266,20 +286,11 @@ matrix<T> matrix<T>::inverse() const {
     if (!is_square())
         throw std::runtime_error("Invert matrix could not be calculated");
 
-    const T determinant = get_determinant();
-    auto result = matrix<T>(row_number_, col_number_);
+    auto identity = matrix<T>(row_number_, col_number_);
     for (size_t row_ = 0; row_ < row_number_; row_++) {
-        for (size_t col_ = 0; col_ < col_number_; col_++) {
-            auto minor = get_minor(row_, col_);
-            T inverse_element = get_inverse_element(row_, col_, minor);
-            if (std::abs(determinant) < 1e-18) {
-                std::cout << determinant << std::endl;
-                throw ZeroDivisionException();
-            }
-            result[col_][row_] = inverse_element / determinant;
-        }
+        identity[row_][row_] = static_cast<T>(1);
     }
-    return result;
+    return solve(identity);
 }
 
 template <typename T>
@@ -297,18 +308,20 @@ matrix<T> matrix<T>::get_minor(const size_t row_, const size_t col_) const {
                 data_row++;
             if (data_col >= col_)
                 data_col++;
-            result[minor_row][minor_col] = data[data_row][data_col];
+            result[minor_row][minor_col] = (*this)[data_row][data_col];
         }
     }
     return result;
 }
 
 template <typename T>
-T matrix<T>::get_inverse_element(const size_t row_, const size_t col_, const matrix<T>& minor) const {
-    T element = minor.get_determinant();
-    if ((row_ + col_) % 2 == 1)
-        element *= -1;
-    return element;
+lu_factorization<T> matrix<T>::factorize() const {
+    return lu_factorization<T>(*this);
+}
+
+template <typename T>
+matrix<T> matrix<T>::solve(const matrix<T>& right_side) const {
+    return factorize().solve(right_side);
 }
 
 template <typename T>
@@ -316,111 +329,321 @@ T matrix<T>::get_determinant() const {
     if (row_number_ != col_number_)
         throw std::runtime_error("Cannot calculate matrix determinant");
 
-    try {
-        auto[lower, upper] = get_decomposition();
-        T lower_determinant = static_cast<T>(1);
-        T upper_determinant = static_cast<T>(1);
-        for (size_t row_ = 0; row_ < row_number_; row_++) {
-            lower_determinant *= lower[row_][row_];
-            upper_determinant *= upper[row_][row_];
+    return factorize().get_determinant();
+}
+
+template <typename T>
+void matrix<T>::print() const {
+    std::cout << row_number_ << " " << col_number_ << std::endl;
+    for (size_t row_ = 0; row_ < row_number_; row_++) {
+        for (size_t col_ = 0; col_ < col_number_; col_++) {
+            std::cout << (*this)[row_][col_] << " ";
         }
-        return lower_determinant * upper_determinant;
-    } catch(...) {
-        return 0;
+        std::cout << std::endl;
     }
 }
 
 template <typename T>
-std::pair<matrix<T>, matrix<T>> matrix<T>::get_decomposition() const {
-    if (!is_square())
-        throw std::runtime_error("Cannot make matrix decomposition");
-
-    auto lower = matrix<T>(row_number_, col_number_);
-    lower.initialize_lower();
-    auto upper = matrix<T>(row_number_, col_number_);
-    fill_decomposition(lower, upper);
-    return std::make_pair(lower, upper);
-}
+bool matrix<T>::is_equal(const matrix<T>& another_matrix) const {
+    if (!is_equal_size(another_matrix))
+        return false;
 
-template<typename T>
-void matrix<T>::fill_decomposition(matrix<T>& lower, matrix<T>& upper) const {
     for (size_t row_ = 0; row_ < row_number_; row_++) {
         for (size_t col_ = 0; col_ < col_number_; col_++) {
-            if (row_ <= col_) {
-                fill_upper_iteration(lower, upper, row_, col_);
-            } else {
-                fill_lower_iteration(lower, upper, row_, col_);
-            }
+            if (!is_equal((*this)[row_][col_], another_matrix[row_][col_]))
+                return false;
         }
     }
+    return true;
+}
+
+template <typename T>
+bool matrix<T>::is_equal(T matrix_element, T another_matrix_element) const {
+    return matrix_element == another_matrix_element;
 }
+template <>
+bool matrix<double>::is_equal(double matrix_element, double another_matrix_element) const;
+template <>
+bool matrix<float>::is_equal(float matrix_element, float another_matrix_element) const;
+template <>
+bool matrix<std::complex<double>>::is_equal(std::complex<double> matrix_element,
+                                            std::complex<double> another_matrix_element) const;
+
+// Absolute: 0 Ohm branches make nodal conductances span more than the double precision,
+// any scale-relative cutoff would reject valid pivots of large resistances
+constexpr double Singularity_threshold = 1e-18;
+
+template <typename T>
+class lu_factorization {
+public:
+    explicit lu_factorization(const matrix<T>& matrix_);
+
+    size_t get_size() const { return factors.get_row_number(); }
+    size_t get_rank() const { return rank; }
+    bool is_singular() const { return rank < get_size(); }
+    const std::vector<size_t>& get_singular_columns() const { return singular_columns; }
+
+    T get_determinant() const;
+    matrix<T> solve(const matrix<T>& right_side) const;
+
+private:
+    matrix<T> factors;
+    std::vector<size_t> row_permutation;
+    std::vector<size_t> singular_columns;
+    size_t rank = 0;
+    bool is_odd_permutation = false;
+
+    void decompose();
+    size_t find_pivot_row(size_t pivot_index) const;
+    void exchange_rows(size_t pivot_index, size_t pivot_row);
+    void eliminate_column(size_t pivot_index);
+    void forward_substitution(matrix<T>& solution) const;
+    void backward_substitution(matrix<T>& solution) const;
+    matrix<T> permute_right_side(const matrix<T>& right_side) const;
+};
 
-template<typename T>
-void matrix<T>::fill_lower_iteration(matrix<T> &lower, const matrix<T> &upper, size_t row_, size_t col_) const {
-    const T divider = upper[col_][col_];
-    if (std::abs(divider) < 1e-18) {
-        throw ZeroDivisionException();
+template <typename T>
+lu_factorization<T>::lu_factorization(const matrix<T>& matrix_):
+    factors(matrix_),
+    row_permutation(matrix_.get_row_number())
+{
+    if (!factors.is_square())
+        throw std::runtime_error("Cannot make matrix decomposition");
+    std::iota(row_permutation.begin(), row_permutation.end(), 0);
+    decompose();
+}
+
+template <typename T>
+void lu_factorization<T>::decompose() {
+    for (size_t pivot_index = 0; pivot_index < get_size(); pivot_index++) {
+        exchange_rows(pivot_index, find_pivot_row(pivot_index));
+        if (std::abs(factors[pivot_index][pivot_index]) <= Singularity_threshold) {
+            singular_columns.push_back(pivot_index);
+            continue;
+        }
+        rank++;
+        eliminate_column(pivot_index);
+    }
+}
+
+template <typename T>
+size_t lu_factorization<T>::find_pivot_row(size_t pivot_index) const {
+    size_t pivot_row = pivot_index;
+    for (size_t row_ = pivot_index + 1; row_ < get_size(); row_++) {
+        if (std::abs(factors[row_][pivot_index]) > std::abs(factors[pivot_row][pivot_index]))
+            pivot_row = row_;
     }
-    lower[row_][col_] = data[row_][col_] / divider;
-    for (size_t variate_col = 0; variate_col < col_; variate_col++) {
-        lower[row_][col_] -= lower[row_][variate_col] * upper[variate_col][col_] / divider;
+    return pivot_row;
+}
+
+template <typename T>
+void lu_factorization<T>::exchange_rows(size_t pivot_index, size_t pivot_row) {
+    if (pivot_row == pivot_index)
+        return;
+    factors.swap_rows(pivot_index, pivot_row);
+    std::swap(row_permutation[pivot_index], row_permutation[pivot_row]);
+    is_odd_permutation = !is_odd_permutation;
+}
+
+template <typename T>
+void lu_factorization<T>::eliminate_column(size_t pivot_index) {
+    const T pivot = factors[pivot_index][pivot_index];
+    const T* pivot_row = factors[pivot_index];
+    for (size_t row_ = pivot_index + 1; row_ < get_size(); row_++) {
+        T* current_row = factors[row_];
+        current_row[pivot_index] /= pivot;
+        const T multiplier = current_row[pivot_index];
+        if (multiplier == static_cast<T>(0))
+            continue;
+        for (size_t col_ = pivot_index + 1; col_ < get_size(); col_++) {
+            current_row[col_] -= multiplier * pivot_row[col_];
+        }
     }
 }
 
-template<typename T>
-void matrix<T>::fill_upper_iteration(const matrix<T> &lower, matrix<T> &upper, size_t row_, size_t col_) const {
-    upper[row_][col_] = data[row_][col_];
-    for (size_t variate_row = 0; variate_row < row_; variate_row++) {
-        upper[row_][col_] -= lower[row_][variate_row] * upper[variate_row][col_];
+template <typename T>
+T lu_factorization<T>::get_determinant() const {
+    if (is_singular())
+        return static_cast<T>(0);
+    T determinant = static_cast<T>(is_odd_permutation ? -1 : 1);
+    for (size_t row_ = 0; row_ < get_size(); row_++) {
+        determinant *= factors[row_][row_];
     }
+    return determinant;
 }
 
-template<typename T>
-void matrix<T>::initialize_lower() const {
-    for (size_t row_ = 0; row_ < row_number_; row_++) {
-        for (size_t col_ = 0; col_ < col_number_; col_++) {
-            if (row_ == col_) {
-                data[row_][row_] = static_cast<T>(1);
+template <typename T>
+matrix<T> lu_factorization<T>::solve(const matrix<T>& right_side) const {
+    if (right_side.get_row_number() != get_size())
+        throw std::runtime_error("Linear system could not be solved: right side has wrong size");
+    if (is_singular())
+        throw typename matrix<T>::ZeroDivisionException();
+
+    matrix<T> solution = permute_right_side(right_side);
+    forward_substitution(solution);
+    backward_substitution(solution);
+    return solution;
+}
+
+template <typename T>
+matrix<T> lu_factorization<T>::permute_right_side(const matrix<T>& right_side) const {
+    matrix<T> permuted(right_side.get_row_number(), right_side.get_col_number());
+    for (size_t row_ = 0; row_ < get_size(); row_++) {
+        for (size_t col_ = 0; col_ < right_side.get_col_number(); col_++) {
+            permuted[row_][col_] = right_side[row_permutation[row_]][col_];
+        }
+    }
+    return permuted;
+}
+
+template <typename T>
+void lu_factorization<T>::forward_substitution(matrix<T>& solution) const {
+    for (size_t row_ = 0; row_ < get_size(); row_++) {
+        for (size_t variate_row = 0; variate_row < row_; variate_row++) {
+            const T multiplier = factors[row_][variate_row];
+            if (multiplier == static_cast<T>(0))
+                continue;
+            for (size_t col_ = 0; col_ < solution.get_col_number(); col_++) {
+                solution[row_][col_] -= multiplier * solution[variate_row][col_];
             }
         }
     }
 }
 
 template <typename T>
-void matrix<T>::print() const {
-    std::cout << row_number_ << " " << col_number_ << std::endl;
-    for (size_t row_ = 0; row_ < row_number_; row_++) {
-        for (size_t col_ = 0; col_ < col_number_; col_++) {
-            std::cout << data[row_][col_] << " ";
+void lu_factorization<T>::backward_substitution(matrix<T>& solution) const {
+    for (size_t row_ = get_size(); row_-- > 0;) {
+        for (size_t variate_row = row_ + 1; variate_row < get_size(); variate_row++) {
+            const T multiplier = factors[row_][variate_row];
+            if (multiplier == static_cast<T>(0))
+                continue;
+            for (size_t col_ = 0; col_ < solution.get_col_number(); col_++) {
+                solution[row_][col_] -= multiplier * solution[variate_row][col_];
+            }
+        }
+        for (size_t col_ = 0; col_ < solution.get_col_number(); col_++) {
+            solution[row_][col_] /= factors[row_][row_];
         }
-        std::cout << std::endl;
     }
 }
 
 template <typename T>
-bool matrix<T>::is_equal(const matrix<T>& another_matrix) const {
-    if (!is_equal_size(another_matrix))
-        return false;
+class packed_lower_triangle {
+public:
+    explicit packed_lower_triangle(size_t size_ = 0):
+        size(size_),
+        elements(size_ * (size_ + 1) / 2, static_cast<T>(0)) {}
 
-    for (size_t row_ = 0; row_ < row_number_; row_++) {
-        for (size_t col_ = 0; col_ < col_number_; col_++) {
-            if (!is_equal(data[row_][col_], another_matrix[row_][col_]))
-                return false;
+    size_t get_size() const { return size; }
+
+    T* operator[](const size_t row_index) { return elements.data() + row_index * (row_index + 1) / 2; }
+
+    const T* operator[](const size_t row_index) const { return elements.data() + row_index * (row_index + 1) / 2; }
+
+private:
+    size_t size;
+    std::vector<T> elements;
+};
+
+template <typename T>
+class ldl_factorization {
+public:
+    explicit ldl_factorization(const matrix<T>& matrix_, bool is_positive_definite_ = false);
+
+    size_t get_size() const { return factors.get_size(); }
+    bool is_singular() const { return singular; }
+
+    matrix<T> solve(const matrix<T>& right_side) const;
+
+private:
+    packed_lower_triangle<T> factors;
+    bool is_positive_definite;
+    bool singular = false;
+
+    void decompose(const matrix<T>& matrix_);
+    bool is_acceptable_pivot(T pivot) const;
+};
+
+template <typename T>
+ldl_factorization<T>::ldl_factorization(const matrix<T>& matrix_, bool is_positive_definite_):
+    factors(matrix_.get_row_number()),
+    is_positive_definite(is_positive_definite_)
+{
+    if (!matrix_.is_square())
+        throw std::runtime_error("Cannot make matrix decomposition");
+    decompose(matrix_);
+}
+
+template <typename T>
+void ldl_factorization<T>::decompose(const matrix<T>& matrix_) {
+    std::vector<T> scaled_row(get_size());
+    for (size_t row_ = 0; row_ < get_size(); row_++) {
+        T* factor_row = factors[row_];
+        for (size_t col_ = 0; col_ < row_; col_++) {
+            const T* factor_col = factors[col_];
+            T sum = matrix_[row_][col_];
+            for (size_t inner = 0; inner < col_; inner++) {
+                sum -= scaled_row[inner] * factor_col[inner];
+            }
+            scaled_row[col_] = sum;
+            factor_row[col_] = sum / factor_col[col_];
+        }
+        T pivot = matrix_[row_][row_];
+        for (size_t inner = 0; inner < row_; inner++) {
+            pivot -= scaled_row[inner] * factor_row[inner];
+        }
+        if (!is_acceptable_pivot(pivot)) {
+            singular = true;
+            return;
         }
+        factor_row[row_] = pivot;
     }
-    return true;
 }
 
 template <typename T>
-bool matrix<T>::is_equal(T matrix_element, T another_matrix_element) const {
-    return matrix_element == another_matrix_element;
+bool ldl_factorization<T>::is_acceptable_pivot(T pivot) const {
+    if (is_positive_definite)
+        return std::real(pivot) > Singularity_threshold && std::imag(pivot) == 0.;
+    return std::abs(pivot) > Singularity_threshold;
 }
-template <>
-bool matrix<double>::is_equal(double matrix_element, double another_matrix_element) const;
-template <>
-bool matrix<float>::is_equal(float matrix_element, float another_matrix_element) const;
-template <>
-bool matrix<std::complex<double>>::is_equal(std::complex<double> matrix_element,
-                                            std::complex<double> another_matrix_element) const;
+
+template <typename T>
+matrix<T> ldl_factorization<T>::solve(const matrix<T>& right_side) const {
+    if (right_side.get_row_number() != get_size())
+        throw std::runtime_error("Linear system could not be solved: right side has wrong size");
+    if (is_singular())
+        throw typename matrix<T>::ZeroDivisionException();
+
+    matrix<T> solution(right_side);
+    for (size_t row_ = 0; row_ < get_size(); row_++) {
+        const T* factor_row = factors[row_];
+        for (size_t variate_row = 0; variate_row < row_; variate_row++) {
+            for (size_t col_ = 0; col_ < solution.get_col_number(); col_++) {
+                solution[row_][col_] -= factor_row[variate_row] * solution[variate_row][col_];
+            }
+        }
+    }
+    for (size_t row_ = 0; row_ < get_size(); row_++) {
+        for (size_t col_ = 0; col_ < solution.get_col_number(); col_++) {
+            solution[row_][col_] /= factors[row_][row_];
+        }
+    }
+    for (size_t row_ = get_size(); row_-- > 0;) {
+        const T* factor_row = factors[row_];
+        for (size_t variate_row = 0; variate_row < row_; variate_row++) {
+            for (size_t col_ = 0; col_ < solution.get_col_number(); col_++) {
+                solution[variate_row][col_] -= factor_row[variate_row] * solution[row_][col_];
+            }
+        }
+    }
+    return solution;
+}
+
+template <typename T>
+class cholesky_factorization : public ldl_factorization<T> {
+public:
+    explicit cholesky_factorization(const matrix<T>& matrix_):
+        ldl_factorization<T>(matrix_, true) {}
+};
 
 #endif //CIRCUITS_MATRIX_H
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include "netlist_reader.h"
+
+netlist_reader::netlist_reader(size_t thread_number_, size_t chunk_size_, size_t block_size_):
+    thread_number(std::max<size_t>(thread_number_, 1)),
+    chunk_size(std::max<size_t>(chunk_size_, 1)),
+    block_size(std::max<size_t>(block_size_, 1))
+{}
+
+void netlist_reader::read(std::string_view input, const edges_consumer &consume) {
+    is_ac = input_parser::is_alternating_current(input);
+    read_region(input, input_parser::cursor(), input.size(), true, consume);
+}
+
+void netlist_reader::read(std::istream &input, const edges_consumer &consume) {
+    std::string buffer;
+    input_parser::cursor start;
+    size_t dropped_lines = 0;
+    size_t dropped_columns = 0;
+    bool is_first_block = true;
+    bool is_final = false;
+    while (!is_final) {
+        const size_t filled_size = buffer.size();
+        buffer.resize(filled_size + block_size);
+        input.read(buffer.data() + filled_size, static_cast<std::streamsize>(block_size));
+        buffer.resize(filled_size + input.gcount());
+        is_final = !input;
+        if (is_first_block) {
+            is_ac = input_parser::is_alternating_current(buffer);
+            is_first_block = false;
+        }
+
+        size_t end = buffer.size();
+        if (!is_final) {
+            const size_t line_end = buffer.rfind('\n');
+            if (line_end == std::string::npos)
+                continue;
+            end = line_end + 1;
+        }
+        try {
+            start = read_region(buffer, start, end, is_final, consume);
+        } catch (const input_parser::InvalidInputException& exception) {
+            const size_t column = exception.get_line() == 1 ? exception.get_column() + dropped_columns
+                                                            : exception.get_column();
+            throw input_parser::InvalidInputException(exception.get_character(),
+                                                      exception.get_line() + dropped_lines, column);
+        }
+
+        const size_t dropped_size = start.is_vertex_pending ? start.pending_position : start.position;
+        const std::string_view dropped_text(buffer.data(), dropped_size);
+        const size_t line_number = std::count(dropped_text.begin(), dropped_text.end(), '\n');
+        if (line_number > 0) {
+            dropped_lines += line_number;
+            dropped_columns = dropped_size - dropped_text.rfind('\n') - 1;
+        } else {
+            dropped_columns += dropped_size;
+        }
+        buffer.erase(0, dropped_size);
+        start.position -= dropped_size;
+        if (start.is_vertex_pending)
+            start.pending_position -= dropped_size;
+    }
+}
+
+input_parser::cursor netlist_reader::read_region(std::string_view buffer, const input_parser::cursor &start,
+                                                 size_t end, bool is_final, const edges_consumer &consume) {
+    const auto bounds = get_chunk_bounds(buffer, start.position, end);
+    std::vector<chunk> chunks(bounds.size() - 1);
+    if (chunks.size() == 1) {
+        chunks[0] = parse_chunk(buffer, start, end, is_final);
+    } else {
+        if (!pool)
+            pool = std::make_unique<thread_pool>(thread_number);
+        std::vector<std::future<void>> chunk_results;
+        for (size_t chunk_index = 0; chunk_index < chunks.size(); chunk_index++) {
+            input_parser::cursor chunk_start = start;
+            if (chunk_index > 0)
+                chunk_start = input_parser::cursor{bounds[chunk_index]};
+            chunk_results.push_back(pool->submit([&, chunk_index, chunk_start] {
+                chunks[chunk_index] = parse_chunk(buffer, chunk_start, bounds[chunk_index + 1], is_final);
+            }));
+        }
+        for (auto& chunk_result : chunk_results) {
+            chunk_result.get();
+        }
+    }
+
+    input_parser::cursor finish = start;
+    for (size_t chunk_index = 0; chunk_index < chunks.size(); chunk_index++) {
+        if (!is_same_start(buffer, finish, chunks[chunk_index].start))
+            chunks[chunk_index] = parse_chunk(buffer, finish, bounds[chunk_index + 1], is_final);
+        if (!chunks[chunk_index].chunk_edges.empty())
+            consume(chunks[chunk_index].chunk_edges);
+        if (chunks[chunk_index].error)
+            std::rethrow_exception(chunks[chunk_index].error);
+        finish = chunks[chunk_index].finish;
+        chunks[chunk_index].chunk_edges = edges();
+    }
+    return finish;
+}
+
+std::vector<size_t> netlist_reader::get_chunk_bounds(std::string_view buffer, size_t begin, size_t end) const {
+    std::vector<size_t> bounds{begin};
+    const size_t chunk_number = end > begin ? std::min(thread_number, (end - begin) / chunk_size) : 0;
+    for (size_t chunk_index = 1; chunk_index < chunk_number; chunk_index++) {
+        size_t bound = buffer.find('\n', begin + (end - begin) * chunk_index / chunk_number);
+        if (bound >= end)
+            break;
+        while (bound < end && isspace(static_cast<unsigned char>(buffer[bound])))
+            bound++;
+        if (bound >= end)
+            break;
+        if (bound > bounds.back())
+            bounds.push_back(bound);
+    }
+    bounds.push_back(std::max(begin, end));
+    return bounds;
+}
+
+netlist_reader::chunk netlist_reader::parse_chunk(std::string_view buffer, const input_parser::cursor &start,
+                                                  size_t end, bool is_final) const {
+    chunk result;
+    result.start = start;
+    input_parser parser(buffer, is_ac, start);
+    input_parser::cursor edge_start = start;
+    try {
+        while (!parser.is_eof() && parser.get_next_edge_position() < end) {
+            edge_start = parser.get_cursor();
+            parser.make_iteration();
+            // The edge could continue in the next block
+            if (!is_final && parser.is_eof()) {
+                result.finish = edge_start;
+                return result;
+            }
+            auto edge = parser.get_current_edge_info();
+            if (!parser.is_emf_included())
+                edge.emf = 0.;
+            result.chunk_edges.push_back(edge);
+        }
+    } catch (const input_parser::InvalidInputException&) {
+        if (!is_final && parser.get_cursor().position + 1 >= buffer.size()) {
+            result.finish = edge_start;
+            return result;
+        }
+        result.error = std::current_exception();
+    }
+    result.finish = parser.get_cursor();
+    return result;
+}
+
+bool netlist_reader::is_same_start(std::string_view buffer, const input_parser::cursor &start,
+                                   const input_parser::cursor &chunk_start) {
+    if (!start.is_vertex_pending && !chunk_start.is_vertex_pending)
+        return start.position == chunk_start.position;
+    if (chunk_start.is_vertex_pending)
+        return start.is_vertex_pending && start.position == chunk_start.position &&
+               start.pending_vertex == chunk_start.pending_vertex;
+    if (start.pending_position != chunk_start.position)
+        return false;
+    // The number read ahead is parsed as a vertex by the chunk, which is the same for short integers only
+    const size_t Max_vertex_digits = 9;
+    size_t digits_end = start.pending_position;
+    while (digits_end < start.position && isdigit(static_cast<unsigned char>(buffer[digits_end])))
+        digits_end++;
+    if (digits_end == start.pending_position || digits_end - start.pending_position > Max_vertex_digits)
+        return false;
+    while (digits_end < start.position && isspace(static_cast<unsigned char>(buffer[digits_end])))
+        digits_end++;
+    return digits_end == start.position;
+}
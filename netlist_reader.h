@@ -0,0 +1,53 @@
+#ifndef CIRCUITS_NETLIST_READER_H
+#define CIRCUITS_NETLIST_READER_H
+
+#include <exception>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "input_parser.h"
+#include "thread_pool.h"
+
+// Splits the netlist into line-aligned chunks and parses them concurrently. Edges are passed
+// to the consumer in input order, EMF of edges without EMF is zero.
+class netlist_reader {
+public:
+    typedef std::vector<input_parser::state> edges;
+    typedef std::function<void(const edges&)> edges_consumer;
+
+    explicit netlist_reader(size_t thread_number_ = thread_pool::get_default_thread_number(),
+                            size_t chunk_size_ = Default_chunk_size, size_t block_size_ = Default_block_size);
+
+    void read(std::string_view input, const edges_consumer& consume);
+    // Reads the stream block by block, only the unparsed tail of a block is kept
+    void read(std::istream& input, const edges_consumer& consume);
+    bool is_alternating_current() const { return is_ac; }
+
+    static constexpr size_t Default_chunk_size = 1 << 20;
+    static constexpr size_t Default_block_size = 1 << 26;
+
+private:
+    struct chunk {
+        input_parser::cursor start;
+        input_parser::cursor finish;
+        edges chunk_edges;
+        std::exception_ptr error;
+    };
+
+    size_t thread_number;
+    size_t chunk_size;
+    size_t block_size;
+    bool is_ac = false;
+    std::unique_ptr<thread_pool> pool;
+
+    input_parser::cursor read_region(std::string_view buffer, const input_parser::cursor& start, size_t end,
+                                     bool is_final, const edges_consumer& consume);
+    std::vector<size_t> get_chunk_bounds(std::string_view buffer, size_t begin, size_t end) const;
+    chunk parse_chunk(std::string_view buffer, const input_parser::cursor& start, size_t end, bool is_final) const;
+    static bool is_same_start(std::string_view buffer, const input_parser::cursor& start,
+                              const input_parser::cursor& chunk_start);
+};
+
+#endif //CIRCUITS_NETLIST_READER_H
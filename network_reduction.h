@@ -0,0 +1,310 @@
+#ifndef CIRCUITS_NETWORK_REDUCTION_H
+#define CIRCUITS_NETWORK_REDUCTION_H
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <vector>
+#include "graph.h"
+
+template <typename T>
+class network_reduction {
+public:
+    network_reduction(const graph& network, const std::vector<T>& conductivity, const std::vector<T>& emf);
+
+    const graph& get_reduced_graph() const { return reduced_graph; }
+    const std::vector<T>& get_reduced_conductivity() const { return reduced_conductivity; }
+    const std::vector<T>& get_reduced_emf() const { return reduced_emf; }
+    size_t get_edge_number() const { return edge_number; }
+
+    std::vector<T> get_edge_current(const std::vector<T>& reduced_current,
+                                    const std::vector<T>& reduced_voltage) const;
+
+private:
+    enum class node_type { edge, series, parallel };
+
+    struct child {
+        size_t node;
+        bool is_reversed;
+    };
+
+    struct node {
+        node_type type;
+        T conductivity;
+        T resistance;
+        T emf;
+        std::vector<child> children;
+    };
+
+    struct branch {
+        graph::vertex outcoming;
+        graph::vertex incoming;
+        size_t node;
+        bool is_removed;
+    };
+
+    static constexpr double Singularity_tolerance = 1e-9;
+
+    size_t edge_number;
+    std::vector<node> nodes;
+    std::vector<branch> branches;
+    std::vector<std::vector<size_t>> vertex_branches;
+    std::vector<size_t> open_nodes;
+    std::vector<size_t> reduced_nodes;
+    graph reduced_graph;
+    std::vector<T> reduced_conductivity;
+    std::vector<T> reduced_emf;
+
+    void reduce();
+    void merge_all_parallel_branches();
+    bool merge_parallel_branches(const std::vector<size_t>& parallel_branches);
+    bool merge_series_branches(graph::vertex vertex_);
+    void remove_dangling_branch(graph::vertex vertex_);
+    std::vector<size_t>& get_vertex_branches(graph::vertex vertex_);
+    std::vector<size_t> find_parallel_branches(size_t branch_index);
+    void add_branch(graph::vertex outcoming, graph::vertex incoming, size_t node_index);
+    graph::vertex get_opposite_vertex(size_t branch_index, graph::vertex vertex_) const;
+    void build_reduced_network();
+
+    static bool is_negligible(T value, double scale);
+    static T get_oriented(T value, bool is_reversed);
+};
+
+template <typename T>
+network_reduction<T>::network_reduction(const graph& network, const std::vector<T>& conductivity,
+                                        const std::vector<T>& emf):
+    edge_number(network.get_edge_number()),
+    vertex_branches(network.get_vertex_number())
+{
+    nodes.reserve(2 * edge_number);
+    for (graph::edge edge = 0; edge < edge_number; edge++) {
+        nodes.push_back({node_type::edge, conductivity[edge], static_cast<T>(1) / conductivity[edge], emf[edge], {}});
+        auto [outcoming, incoming] = network.get_tied_vertices(edge);
+        add_branch(outcoming, incoming, edge);
+    }
+    reduce();
+    build_reduced_network();
+}
+
+template <typename T>
+void network_reduction<T>::reduce() {
+    merge_all_parallel_branches();
+    std::vector<graph::vertex> vertex_queue(vertex_branches.size());
+    for (graph::vertex vertex_ = 0; vertex_ < vertex_queue.size(); vertex_++) {
+        vertex_queue[vertex_] = vertex_queue.size() - 1 - vertex_;
+    }
+    while (!vertex_queue.empty()) {
+        const graph::vertex vertex_ = vertex_queue.back();
+        vertex_queue.pop_back();
+        auto& current_branches = get_vertex_branches(vertex_);
+        if (current_branches.size() == 1) {
+            const graph::vertex opposite_vertex = get_opposite_vertex(current_branches.front(), vertex_);
+            remove_dangling_branch(vertex_);
+            vertex_queue.push_back(opposite_vertex);
+        } else if (current_branches.size() == 2) {
+            const graph::vertex first_vertex = get_opposite_vertex(current_branches[0], vertex_);
+            const graph::vertex second_vertex = get_opposite_vertex(current_branches[1], vertex_);
+            if (first_vertex == second_vertex || !merge_series_branches(vertex_))
+                continue;
+            auto parallel_branches = find_parallel_branches(branches.size() - 1);
+            if (parallel_branches.size() > 1)
+                merge_parallel_branches(parallel_branches);
+            vertex_queue.push_back(first_vertex);
+            vertex_queue.push_back(second_vertex);
+        }
+    }
+}
+
+template <typename T>
+void network_reduction<T>::merge_all_parallel_branches() {
+    std::vector<std::tuple<graph::vertex, graph::vertex, size_t>> vertex_pairs;
+    vertex_pairs.reserve(branches.size());
+    for (size_t branch_index = 0; branch_index < branches.size(); branch_index++) {
+        const auto& branch_ = branches[branch_index];
+        vertex_pairs.emplace_back(std::min(branch_.outcoming, branch_.incoming),
+                                  std::max(branch_.outcoming, branch_.incoming), branch_index);
+    }
+    std::sort(vertex_pairs.begin(), vertex_pairs.end());
+    for (size_t first = 0, last = 0; first < vertex_pairs.size(); first = last) {
+        std::vector<size_t> parallel_branches;
+        for (last = first; last < vertex_pairs.size() &&
+                           std::get<0>(vertex_pairs[last]) == std::get<0>(vertex_pairs[first]) &&
+                           std::get<1>(vertex_pairs[last]) == std::get<1>(vertex_pairs[first]); last++) {
+            parallel_branches.push_back(std::get<2>(vertex_pairs[last]));
+        }
+        if (parallel_branches.size() > 1)
+            merge_parallel_branches(parallel_branches);
+    }
+}
+
+template <typename T>
+bool network_reduction<T>::merge_parallel_branches(const std::vector<size_t>& parallel_branches) {
+    const auto& reference_branch = branches[parallel_branches.front()];
+    node merged_node{node_type::parallel, static_cast<T>(0), static_cast<T>(0), static_cast<T>(0), {}};
+    double conductivity_scale = 0.;
+    for (size_t branch_index : parallel_branches) {
+        const auto& node_ = nodes[branches[branch_index].node];
+        const bool is_reversed = branches[branch_index].outcoming != reference_branch.outcoming;
+        merged_node.conductivity += node_.conductivity;
+        merged_node.emf += get_oriented(node_.conductivity * node_.emf, is_reversed);
+        merged_node.children.push_back({branches[branch_index].node, is_reversed});
+        conductivity_scale += std::abs(node_.conductivity);
+    }
+    if (is_negligible(merged_node.conductivity, conductivity_scale))
+        return false;
+    merged_node.resistance = static_cast<T>(1) / merged_node.conductivity;
+    merged_node.emf /= merged_node.conductivity;
+
+    const graph::vertex outcoming = reference_branch.outcoming, incoming = reference_branch.incoming;
+    for (size_t branch_index : parallel_branches) {
+        branches[branch_index].is_removed = true;
+    }
+    nodes.push_back(std::move(merged_node));
+    add_branch(outcoming, incoming, nodes.size() - 1);
+    return true;
+}
+
+template <typename T>
+bool network_reduction<T>::merge_series_branches(graph::vertex vertex_) {
+    const auto series_branches = get_vertex_branches(vertex_);
+    const graph::vertex outcoming = get_opposite_vertex(series_branches[0], vertex_);
+    const graph::vertex incoming = get_opposite_vertex(series_branches[1], vertex_);
+    const bool is_first_reversed = branches[series_branches[0]].outcoming != outcoming;
+    const bool is_second_reversed = branches[series_branches[1]].outcoming != vertex_;
+    const auto& first_node = nodes[branches[series_branches[0]].node];
+    const auto& second_node = nodes[branches[series_branches[1]].node];
+
+    node merged_node{node_type::series, static_cast<T>(0), first_node.resistance + second_node.resistance,
+                     get_oriented(first_node.emf, is_first_reversed) +
+                     get_oriented(second_node.emf, is_second_reversed),
+                     {{branches[series_branches[0]].node, is_first_reversed},
+                      {branches[series_branches[1]].node, is_second_reversed}}};
+    if (is_negligible(merged_node.resistance, std::abs(first_node.resistance) + std::abs(second_node.resistance)))
+        return false;
+    merged_node.conductivity = static_cast<T>(1) / merged_node.resistance;
+
+    branches[series_branches[0]].is_removed = true;
+    branches[series_branches[1]].is_removed = true;
+    nodes.push_back(std::move(merged_node));
+    add_branch(outcoming, incoming, nodes.size() - 1);
+    return true;
+}
+
+template <typename T>
+void network_reduction<T>::remove_dangling_branch(graph::vertex vertex_) {
+    const size_t branch_index = get_vertex_branches(vertex_).front();
+    branches[branch_index].is_removed = true;
+    open_nodes.push_back(branches[branch_index].node);
+}
+
+template <typename T>
+std::vector<size_t>& network_reduction<T>::get_vertex_branches(graph::vertex vertex_) {
+    auto& current_branches = vertex_branches[vertex_];
+    current_branches.erase(std::remove_if(current_branches.begin(), current_branches.end(),
+                                          [this](size_t branch_index) { return branches[branch_index].is_removed; }),
+                           current_branches.end());
+    return current_branches;
+}
+
+template <typename T>
+std::vector<size_t> network_reduction<T>::find_parallel_branches(size_t branch_index) {
+    const graph::vertex outcoming = branches[branch_index].outcoming, incoming = branches[branch_index].incoming;
+    const auto& outcoming_branches = get_vertex_branches(outcoming);
+    const auto& incoming_branches = get_vertex_branches(incoming);
+    const bool is_outcoming_smaller = outcoming_branches.size() <= incoming_branches.size();
+    const graph::vertex vertex_ = is_outcoming_smaller ? outcoming : incoming;
+    const graph::vertex opposite_vertex = is_outcoming_smaller ? incoming : outcoming;
+
+    std::vector<size_t> parallel_branches{branch_index};
+    for (size_t another_branch : is_outcoming_smaller ? outcoming_branches : incoming_branches) {
+        if (another_branch != branch_index && get_opposite_vertex(another_branch, vertex_) == opposite_vertex)
+            parallel_branches.push_back(another_branch);
+    }
+    return parallel_branches;
+}
+
+template <typename T>
+void network_reduction<T>::add_branch(graph::vertex outcoming, graph::vertex incoming, size_t node_index) {
+    vertex_branches[outcoming].push_back(branches.size());
+    vertex_branches[incoming].push_back(branches.size());
+    branches.push_back({outcoming, incoming, node_index, false});
+}
+
+template <typename T>
+graph::vertex network_reduction<T>::get_opposite_vertex(size_t branch_index, graph::vertex vertex_) const {
+    const auto& branch_ = branches[branch_index];
+    return branch_.outcoming == vertex_ ? branch_.incoming : branch_.outcoming;
+}
+
+template <typename T>
+void network_reduction<T>::build_reduced_network() {
+    std::vector<graph::vertex> reduced_vertex(vertex_branches.size(), vertex_branches.size());
+    for (const auto& branch_ : branches) {
+        if (!branch_.is_removed)
+            reduced_vertex[branch_.outcoming] = reduced_vertex[branch_.incoming] = 0;
+    }
+    graph::vertex vertex_number = 0;
+    for (auto& vertex_ : reduced_vertex) {
+        if (vertex_ != reduced_vertex.size())
+            vertex_ = vertex_number++;
+    }
+    for (const auto& branch_ : branches) {
+        if (branch_.is_removed)
+            continue;
+        reduced_graph.add_edge(reduced_vertex[branch_.outcoming], reduced_vertex[branch_.incoming]);
+        reduced_nodes.push_back(branch_.node);
+        reduced_conductivity.push_back(nodes[branch_.node].conductivity);
+        reduced_emf.push_back(nodes[branch_.node].emf);
+    }
+    branches.clear();
+    branches.shrink_to_fit();
+    vertex_branches.clear();
+    vertex_branches.shrink_to_fit();
+}
+
+template <typename T>
+std::vector<T> network_reduction<T>::get_edge_current(const std::vector<T>& reduced_current,
+                                                      const std::vector<T>& reduced_voltage) const {
+    std::vector<T> edge_current(edge_number);
+    std::vector<std::tuple<size_t, T, T>> node_stack;
+    for (size_t reduced_edge = 0; reduced_edge < reduced_nodes.size(); reduced_edge++) {
+        node_stack.emplace_back(reduced_nodes[reduced_edge], reduced_current[reduced_edge], reduced_voltage[reduced_edge]);
+    }
+    for (size_t node_index : open_nodes) {
+        node_stack.emplace_back(node_index, static_cast<T>(0), nodes[node_index].emf);
+    }
+    while (!node_stack.empty()) {
+        auto [node_index, current, voltage] = node_stack.back();
+        node_stack.pop_back();
+        const auto& node_ = nodes[node_index];
+        if (node_.type == node_type::edge) {
+            edge_current[node_index] = current;
+        } else if (node_.type == node_type::series) {
+            for (const auto& child_ : node_.children) {
+                const auto& child_node = nodes[child_.node];
+                const T child_current = get_oriented(current, child_.is_reversed);
+                node_stack.emplace_back(child_.node, child_current, child_node.emf - child_current * child_node.resistance);
+            }
+        } else {
+            for (const auto& child_ : node_.children) {
+                const auto& child_node = nodes[child_.node];
+                const T child_voltage = get_oriented(voltage, child_.is_reversed);
+                node_stack.emplace_back(child_.node, child_node.conductivity * (child_node.emf - child_voltage),
+                                        child_voltage);
+            }
+        }
+    }
+    return edge_current;
+}
+
+template <typename T>
+bool network_reduction<T>::is_negligible(T value, double scale) {
+    return std::abs(value) <= Singularity_tolerance * scale;
+}
+
+template <typename T>
+T network_reduction<T>::get_oriented(T value, bool is_reversed) {
+    return is_reversed ? static_cast<T>(0) - value : value;
+}
+
+#endif //CIRCUITS_NETWORK_REDUCTION_H
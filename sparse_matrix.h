@@ -0,0 +1,631 @@
+#ifndef CIRCUITS_SPARSE_MATRIX_H
+#define CIRCUITS_SPARSE_MATRIX_H
+
+#include <cstdint>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+#include <queue>
+#include <functional>
+#include "matrix.h"
+#include "graph.h"
+
+template <typename T>
+class sparse_ldl_factorization;
+
+template <typename T>
+class sparse_matrix {
+public:
+    typedef uint32_t index;
+    struct triplet {
+        index row;
+        index col;
+        T value;
+    };
+    class transposed_view;
+
+    sparse_matrix() = default;
+    sparse_matrix(size_t row_number, size_t col_number, const std::vector<triplet>& triplets);
+    explicit sparse_matrix(const matrix<T>& dense_matrix);
+
+    static sparse_matrix<T> laplacian(const graph& graph_, const std::vector<T>& edge_weights, size_t dimension);
+
+    size_t get_row_number() const { return row_number_; }
+    size_t get_col_number() const { return col_number_; }
+    size_t get_nonzero_number() const { return values.size(); }
+    const std::vector<index>& get_row_offsets() const { return row_offsets; }
+    const std::vector<index>& get_col_indices() const { return col_indices; }
+    const std::vector<T>& get_values() const { return values; }
+
+    T get_element(size_t row_, size_t col_) const;
+    T* find_element(size_t row_, size_t col_);
+
+    std::vector<T> multiply(const std::vector<T>& vector_) const;
+    matrix<T> multiply(const matrix<T>& dense_matrix) const;
+    sparse_matrix<T> multiply(const sparse_matrix<T>& another_matrix) const;
+
+    transposed_view transpose_view() const { return transposed_view(*this); }
+    sparse_matrix<T> transpose() const;
+    matrix<T> to_dense() const;
+
+    sparse_ldl_factorization<T> factorize() const;
+
+private:
+    size_t row_number_ = 0;
+    size_t col_number_ = 0;
+    std::vector<index> row_offsets = std::vector<index>(1, 0);
+    std::vector<index> col_indices;
+    std::vector<T> values;
+
+    static void check_index_range(size_t size);
+    void build_from_triplets(const std::vector<triplet>& triplets);
+    void compress_duplicates();
+};
+
+template <typename T>
+class sparse_matrix<T>::transposed_view {
+public:
+    explicit transposed_view(const sparse_matrix<T>& base_):
+        base(base_) {}
+
+    size_t get_row_number() const { return base.get_col_number(); }
+    size_t get_col_number() const { return base.get_row_number(); }
+
+    std::vector<T> multiply(const std::vector<T>& vector_) const;
+    matrix<T> multiply(const matrix<T>& dense_matrix) const;
+
+private:
+    const sparse_matrix<T>& base;
+};
+
+template <typename T>
+void sparse_matrix<T>::check_index_range(size_t size) {
+    if (size > std::numeric_limits<index>::max())
+        throw std::runtime_error("Sparse matrix is too large for 32-bit indices");
+}
+
+template <typename T>
+sparse_matrix<T>::sparse_matrix(size_t row_number, size_t col_number, const std::vector<triplet>& triplets):
+    row_number_(row_number),
+    col_number_(col_number)
+{
+    check_index_range(row_number_);
+    check_index_range(col_number_);
+    check_index_range(triplets.size());
+    build_from_triplets(triplets);
+}
+
+template <typename T>
+sparse_matrix<T>::sparse_matrix(const matrix<T>& dense_matrix):
+    row_number_(dense_matrix.get_row_number()),
+    col_number_(dense_matrix.get_col_number())
+{
+    check_index_range(row_number_);
+    check_index_range(col_number_);
+    row_offsets.assign(row_number_ + 1, 0);
+    for (size_t row_ = 0; row_ < row_number_; row_++) {
+        for (size_t col_ = 0; col_ < col_number_; col_++) {
+            if (dense_matrix[row_][col_] == static_cast<T>(0))
+                continue;
+            col_indices.push_back(static_cast<index>(col_));
+            values.push_back(dense_matrix[row_][col_]);
+        }
+        check_index_range(values.size());
+        row_offsets[row_ + 1] = static_cast<index>(values.size());
+    }
+}
+
+template <typename T>
+void sparse_matrix<T>::build_from_triplets(const std::vector<triplet>& triplets) {
+    row_offsets.assign(row_number_ + 1, 0);
+    for (const auto& element : triplets) {
+        if (element.row >= row_number_ || element.col >= col_number_)
+            throw std::runtime_error("Sparse matrix element is out of range");
+        row_offsets[element.row + 1]++;
+    }
+    std::partial_sum(row_offsets.begin(), row_offsets.end(), row_offsets.begin());
+
+    col_indices.resize(triplets.size());
+    values.resize(triplets.size());
+    std::vector<index> insert_position(row_offsets.begin(), row_offsets.end() - 1);
+    for (const auto& element : triplets) {
+        const index position = insert_position[element.row]++;
+        col_indices[position] = element.col;
+        values[position] = element.value;
+    }
+    compress_duplicates();
+}
+
+template <typename T>
+void sparse_matrix<T>::compress_duplicates() {
+    std::vector<std::pair<index, T>> row_elements;
+    index compressed_size = 0;
+    for (size_t row_ = 0; row_ < row_number_; row_++) {
+        row_elements.clear();
+        for (index position = row_offsets[row_]; position < row_offsets[row_ + 1]; position++) {
+            row_elements.emplace_back(col_indices[position], values[position]);
+        }
+        std::stable_sort(row_elements.begin(), row_elements.end(),
+                         [](const auto& left, const auto& right) { return left.first < right.first; });
+        row_offsets[row_] = compressed_size;
+        for (size_t element = 0; element < row_elements.size(); element++) {
+            if (element && row_elements[element].first == col_indices[compressed_size - 1]) {
+                values[compressed_size - 1] += row_elements[element].second;
+                continue;
+            }
+            col_indices[compressed_size] = row_elements[element].first;
+            values[compressed_size] = row_elements[element].second;
+            compressed_size++;
+        }
+    }
+    row_offsets[row_number_] = compressed_size;
+    col_indices.resize(compressed_size);
+    values.resize(compressed_size);
+}
+
+template <typename T>
+sparse_matrix<T> sparse_matrix<T>::laplacian(const graph& graph_, const std::vector<T>& edge_weights,
+                                             size_t dimension) {
+    if (edge_weights.size() != graph_.get_edge_number())
+        throw std::runtime_error("Edge weights do not match graph edges");
+
+    std::vector<triplet> triplets;
+    triplets.reserve(4 * graph_.get_edge_number());
+    for (graph::edge edge = 0; edge < graph_.get_edge_number(); edge++) {
+        auto [first, second] = graph_.get_tied_vertices(edge);
+        const T weight = edge_weights[edge];
+        if (first < dimension)
+            triplets.push_back({static_cast<index>(first), static_cast<index>(first), weight});
+        if (second < dimension)
+            triplets.push_back({static_cast<index>(second), static_cast<index>(second), weight});
+        if (first < dimension && second < dimension) {
+            triplets.push_back({static_cast<index>(first), static_cast<index>(second), -weight});
+            triplets.push_back({static_cast<index>(second), static_cast<index>(first), -weight});
+        }
+    }
+    return sparse_matrix<T>(dimension, dimension, triplets);
+}
+
+template <typename T>
+T sparse_matrix<T>::get_element(size_t row_, size_t col_) const {
+    auto row_begin = col_indices.begin() + row_offsets[row_];
+    auto row_end = col_indices.begin() + row_offsets[row_ + 1];
+    auto position = std::lower_bound(row_begin, row_end, col_);
+    if (position == row_end || *position != col_)
+        return static_cast<T>(0);
+    return values[position - col_indices.begin()];
+}
+
+template <typename T>
+T* sparse_matrix<T>::find_element(size_t row_, size_t col_) {
+    auto row_begin = col_indices.begin() + row_offsets[row_];
+    auto row_end = col_indices.begin() + row_offsets[row_ + 1];
+    auto position = std::lower_bound(row_begin, row_end, col_);
+    if (position == row_end || *position != col_)
+        return nullptr;
+    return &values[position - col_indices.begin()];
+}
+
+template <typename T>
+std::vector<T> sparse_matrix<T>::multiply(const std::vector<T>& vector_) const {
+    if (vector_.size() != col_number_)
+        throw std::runtime_error("Matrices could not be multiplied!");
+
+    std::vector<T> result(row_number_, static_cast<T>(0));
+    for (size_t row_ = 0; row_ < row_number_; row_++) {
+        T sum = static_cast<T>(0);
+        for (index position = row_offsets[row_]; position < row_offsets[row_ + 1]; position++) {
+            sum += values[position] * vector_[col_indices[position]];
+        }
+        result[row_] = sum;
+    }
+    return result;
+}
+
+template <typename T>
+matrix<T> sparse_matrix<T>::multiply(const matrix<T>& dense_matrix) const {
+    if (dense_matrix.get_row_number() != col_number_)
+        throw std::runtime_error("Matrices could not be multiplied!");
+
+    matrix<T> result(row_number_, dense_matrix.get_col_number());
+    for (size_t row_ = 0; row_ < row_number_; row_++) {
+        T* result_row = result[row_];
+        for (index position = row_offsets[row_]; position < row_offsets[row_ + 1]; position++) {
+            const T element = values[position];
+            const T* dense_row = dense_matrix[col_indices[position]];
+            for (size_t col_ = 0; col_ < dense_matrix.get_col_number(); col_++) {
+                result_row[col_] += element * dense_row[col_];
+            }
+        }
+    }
+    return result;
+}
+
+template <typename T>
+sparse_matrix<T> sparse_matrix<T>::multiply(const sparse_matrix<T>& another_matrix) const {
+    if (another_matrix.row_number_ != col_number_)
+        throw std::runtime_error("Matrices could not be multiplied!");
+
+    const index No_position = std::numeric_limits<index>::max();
+    sparse_matrix<T> result;
+    result.row_number_ = row_number_;
+    result.col_number_ = another_matrix.col_number_;
+    result.row_offsets.assign(row_number_ + 1, 0);
+    std::vector<index> result_positions(another_matrix.col_number_, No_position);
+    for (size_t row_ = 0; row_ < row_number_; row_++) {
+        const size_t row_begin = result.values.size();
+        for (index position = row_offsets[row_]; position < row_offsets[row_ + 1]; position++) {
+            const T element = values[position];
+            const index inner = col_indices[position];
+            for (index another_position = another_matrix.row_offsets[inner];
+                 another_position < another_matrix.row_offsets[inner + 1]; another_position++) {
+                const index col_ = another_matrix.col_indices[another_position];
+                if (result_positions[col_] == No_position) {
+                    result_positions[col_] = static_cast<index>(result.values.size());
+                    result.col_indices.push_back(col_);
+                    result.values.push_back(element * another_matrix.values[another_position]);
+                } else {
+                    result.values[result_positions[col_]] += element * another_matrix.values[another_position];
+                }
+            }
+        }
+        check_index_range(result.values.size());
+        std::vector<std::pair<index, T>> row_elements;
+        for (size_t position = row_begin; position < result.values.size(); position++) {
+            result_positions[result.col_indices[position]] = No_position;
+            row_elements.emplace_back(result.col_indices[position], result.values[position]);
+        }
+        std::sort(row_elements.begin(), row_elements.end(),
+                  [](const auto& left, const auto& right) { return left.first < right.first; });
+        for (size_t element = 0; element < row_elements.size(); element++) {
+            result.col_indices[row_begin + element] = row_elements[element].first;
+            result.values[row_begin + element] = row_elements[element].second;
+        }
+        result.row_offsets[row_ + 1] = static_cast<index>(result.values.size());
+    }
+    return result;
+}
+
+template <typename T>
+std::vector<T> sparse_matrix<T>::transposed_view::multiply(const std::vector<T>& vector_) const {
+    if (vector_.size() != get_col_number())
+        throw std::runtime_error("Matrices could not be multiplied!");
+
+    std::vector<T> result(get_row_number(), static_cast<T>(0));
+    for (size_t row_ = 0; row_ < base.row_number_; row_++) {
+        const T element = vector_[row_];
+        if (element == static_cast<T>(0))
+            continue;
+        for (index position = base.row_offsets[row_]; position < base.row_offsets[row_ + 1]; position++) {
+            result[base.col_indices[position]] += base.values[position] * element;
+        }
+    }
+    return result;
+}
+
+template <typename T>
+matrix<T> sparse_matrix<T>::transposed_view::multiply(const matrix<T>& dense_matrix) const {
+    if (dense_matrix.get_row_number() != get_col_number())
+        throw std::runtime_error("Matrices could not be multiplied!");
+
+    matrix<T> result(get_row_number(), dense_matrix.get_col_number());
+    for (size_t row_ = 0; row_ < base.row_number_; row_++) {
+        const T* dense_row = dense_matrix[row_];
+        for (index position = base.row_offsets[row_]; position < base.row_offsets[row_ + 1]; position++) {
+            const T element = base.values[position];
+            T* result_row = result[base.col_indices[position]];
+            for (size_t col_ = 0; col_ < dense_matrix.get_col_number(); col_++) {
+                result_row[col_] += element * dense_row[col_];
+            }
+        }
+    }
+    return result;
+}
+
+template <typename T>
+sparse_matrix<T> sparse_matrix<T>::transpose() const {
+    sparse_matrix<T> result;
+    result.row_number_ = col_number_;
+    result.col_number_ = row_number_;
+    result.row_offsets.assign(col_number_ + 1, 0);
+    for (index col_ : col_indices) {
+        result.row_offsets[col_ + 1]++;
+    }
+    std::partial_sum(result.row_offsets.begin(), result.row_offsets.end(), result.row_offsets.begin());
+
+    result.col_indices.resize(values.size());
+    result.values.resize(values.size());
+    std::vector<index> insert_position(result.row_offsets.begin(), result.row_offsets.end() - 1);
+    for (size_t row_ = 0; row_ < row_number_; row_++) {
+        for (index position = row_offsets[row_]; position < row_offsets[row_ + 1]; position++) {
+            const index result_position = insert_position[col_indices[position]]++;
+            result.col_indices[result_position] = static_cast<index>(row_);
+            result.values[result_position] = values[position];
+        }
+    }
+    return result;
+}
+
+template <typename T>
+matrix<T> sparse_matrix<T>::to_dense() const {
+    matrix<T> result(row_number_, col_number_);
+    for (size_t row_ = 0; row_ < row_number_; row_++) {
+        for (index position = row_offsets[row_]; position < row_offsets[row_ + 1]; position++) {
+            result[row_][col_indices[position]] = values[position];
+        }
+    }
+    return result;
+}
+
+template <typename T>
+sparse_ldl_factorization<T> sparse_matrix<T>::factorize() const {
+    return sparse_ldl_factorization<T>(*this);
+}
+
+template <typename T>
+class sparse_ldl_factorization {
+public:
+    typedef typename sparse_matrix<T>::index index;
+
+    explicit sparse_ldl_factorization(const sparse_matrix<T>& matrix_);
+    void refactorize(const sparse_matrix<T>& matrix_);
+
+    size_t get_size() const { return permutation.size(); }
+    bool is_singular() const { return singular; }
+    size_t get_factor_nonzero_number() const { return factor_col_offsets.back(); }
+    const std::vector<index>& get_permutation() const { return permutation; }
+
+    std::vector<T> solve(const std::vector<T>& right_side) const;
+    matrix<T> solve(const matrix<T>& right_side) const;
+
+private:
+    static constexpr index No_parent = std::numeric_limits<index>::max();
+    static constexpr double Pivot_tolerance = 1e-12;
+
+    std::vector<index> permutation;
+    std::vector<index> inverse_permutation;
+    std::vector<index> elimination_parent;
+    std::vector<index> factor_col_offsets;
+    std::vector<index> factor_row_indices;
+    std::vector<T> factor_values;
+    std::vector<T> diagonal;
+    bool singular = false;
+
+    void compute_ordering(const sparse_matrix<T>& matrix_);
+    void analyse(const sparse_matrix<T>& matrix_);
+    void decompose(const sparse_matrix<T>& matrix_);
+    double get_pivot_threshold(const sparse_matrix<T>& matrix_, index row_) const;
+    void substitute(std::vector<T>& solution) const;
+};
+
+template <typename T>
+sparse_ldl_factorization<T>::sparse_ldl_factorization(const sparse_matrix<T>& matrix_) {
+    if (matrix_.get_row_number() != matrix_.get_col_number())
+        throw std::runtime_error("Cannot make matrix decomposition");
+    compute_ordering(matrix_);
+    analyse(matrix_);
+    decompose(matrix_);
+}
+
+template <typename T>
+void sparse_ldl_factorization<T>::refactorize(const sparse_matrix<T>& matrix_) {
+    if (matrix_.get_row_number() != get_size() || matrix_.get_col_number() != get_size())
+        throw std::runtime_error("Cannot make matrix decomposition");
+    decompose(matrix_);
+}
+
+template <typename T>
+void sparse_ldl_factorization<T>::compute_ordering(const sparse_matrix<T>& matrix_) {
+    const size_t size = matrix_.get_row_number();
+    const auto& row_offsets = matrix_.get_row_offsets();
+    const auto& col_indices = matrix_.get_col_indices();
+
+    std::vector<std::vector<index>> adjacency(size);
+    for (size_t row_ = 0; row_ < size; row_++) {
+        for (index position = row_offsets[row_]; position < row_offsets[row_ + 1]; position++) {
+            if (col_indices[position] != row_)
+                adjacency[row_].push_back(col_indices[position]);
+        }
+    }
+
+    typedef std::pair<size_t, index> degree_entry;
+    std::priority_queue<degree_entry, std::vector<degree_entry>, std::greater<>> degree_queue;
+    for (size_t vertex_ = 0; vertex_ < size; vertex_++) {
+        degree_queue.emplace(adjacency[vertex_].size(), static_cast<index>(vertex_));
+    }
+
+    std::vector<bool> eliminated(size, false);
+    std::vector<index> merged;
+    permutation.clear();
+    permutation.reserve(size);
+    while (!degree_queue.empty()) {
+        auto [degree, pivot] = degree_queue.top();
+        degree_queue.pop();
+        if (eliminated[pivot] || degree != adjacency[pivot].size())
+            continue;
+        eliminated[pivot] = true;
+        permutation.push_back(pivot);
+
+        auto neighbours = std::move(adjacency[pivot]);
+        adjacency[pivot].clear();
+        for (index neighbour : neighbours) {
+            auto& neighbour_adjacency = adjacency[neighbour];
+            merged.clear();
+            std::set_union(neighbour_adjacency.begin(), neighbour_adjacency.end(),
+                           neighbours.begin(), neighbours.end(), std::back_inserter(merged));
+            merged.erase(std::remove_if(merged.begin(), merged.end(),
+                                        [&](index vertex_) { return vertex_ == pivot || vertex_ == neighbour; }),
+                         merged.end());
+            neighbour_adjacency.swap(merged);
+            degree_queue.emplace(neighbour_adjacency.size(), neighbour);
+        }
+    }
+
+    inverse_permutation.assign(size, 0);
+    for (size_t position = 0; position < size; position++) {
+        inverse_permutation[permutation[position]] = static_cast<index>(position);
+    }
+}
+
+template <typename T>
+void sparse_ldl_factorization<T>::analyse(const sparse_matrix<T>& matrix_) {
+    const size_t size = get_size();
+    const auto& row_offsets = matrix_.get_row_offsets();
+    const auto& col_indices = matrix_.get_col_indices();
+
+    elimination_parent.assign(size, No_parent);
+    std::vector<index> column_count(size, 0);
+    std::vector<index> visited(size, 0);
+    for (index column = 0; column < size; column++) {
+        visited[column] = column;
+        const index original_row = permutation[column];
+        for (index position = row_offsets[original_row]; position < row_offsets[original_row + 1]; position++) {
+            for (index row_ = inverse_permutation[col_indices[position]];
+                 row_ < column && visited[row_] != column; row_ = elimination_parent[row_]) {
+                if (elimination_parent[row_] == No_parent)
+                    elimination_parent[row_] = column;
+                column_count[row_]++;
+                visited[row_] = column;
+            }
+        }
+    }
+
+    factor_col_offsets.assign(size + 1, 0);
+    for (size_t column = 0; column < size; column++) {
+        if (factor_col_offsets[column] > std::numeric_limits<index>::max() - column_count[column])
+            throw std::runtime_error("Sparse factorization is too large for 32-bit indices");
+        factor_col_offsets[column + 1] = factor_col_offsets[column] + column_count[column];
+    }
+    factor_row_indices.resize(factor_col_offsets.back());
+    factor_values.resize(factor_col_offsets.back());
+    diagonal.resize(size);
+}
+
+template <typename T>
+double sparse_ldl_factorization<T>::get_pivot_threshold(const sparse_matrix<T>& matrix_, index row_) const {
+    const auto& row_offsets = matrix_.get_row_offsets();
+    const auto& values = matrix_.get_values();
+    double max_element = 0.;
+    for (index position = row_offsets[row_]; position < row_offsets[row_ + 1]; position++) {
+        max_element = std::max(max_element, static_cast<double>(std::abs(values[position])));
+    }
+    return std::max(1e-18, max_element * Pivot_tolerance);
+}
+
+template <typename T>
+void sparse_ldl_factorization<T>::decompose(const sparse_matrix<T>& matrix_) {
+    const size_t size = get_size();
+    const auto& row_offsets = matrix_.get_row_offsets();
+    const auto& col_indices = matrix_.get_col_indices();
+    const auto& values = matrix_.get_values();
+
+    singular = false;
+    std::vector<T> row_values(size, static_cast<T>(0));
+    std::vector<index> pattern(size);
+    std::vector<index> visited(size, 0);
+    std::vector<index> filled(size, 0);
+    for (index row_ = 0; row_ < size; row_++) {
+        visited[row_] = row_;
+        size_t top = size;
+        const index original_row = permutation[row_];
+        for (index position = row_offsets[original_row]; position < row_offsets[original_row + 1]; position++) {
+            index column = inverse_permutation[col_indices[position]];
+            if (column > row_)
+                continue;
+            row_values[column] += values[position];
+            size_t path_length = 0;
+            for (; visited[column] != row_; column = elimination_parent[column]) {
+                pattern[path_length++] = column;
+                visited[column] = row_;
+            }
+            while (path_length > 0) {
+                pattern[--top] = pattern[--path_length];
+            }
+        }
+
+        T pivot = row_values[row_];
+        row_values[row_] = static_cast<T>(0);
+        for (; top < size; top++) {
+            const index column = pattern[top];
+            const T row_value = row_values[column];
+            row_values[column] = static_cast<T>(0);
+            const index column_end = factor_col_offsets[column] + filled[column];
+            for (index position = factor_col_offsets[column]; position < column_end; position++) {
+                row_values[factor_row_indices[position]] -= factor_values[position] * row_value;
+            }
+            const T multiplier = row_value / diagonal[column];
+            pivot -= multiplier * row_value;
+            factor_row_indices[column_end] = row_;
+            factor_values[column_end] = multiplier;
+            filled[column]++;
+        }
+        diagonal[row_] = pivot;
+        if (std::abs(pivot) <= get_pivot_threshold(matrix_, original_row)) {
+            singular = true;
+            return;
+        }
+    }
+}
+
+template <typename T>
+std::vector<T> sparse_ldl_factorization<T>::solve(const std::vector<T>& right_side) const {
+    if (right_side.size() != get_size())
+        throw std::runtime_error("Linear system could not be solved: right side has wrong size");
+    if (is_singular())
+        throw typename matrix<T>::ZeroDivisionException();
+
+    std::vector<T> solution(get_size());
+    for (size_t row_ = 0; row_ < get_size(); row_++) {
+        solution[row_] = right_side[permutation[row_]];
+    }
+    substitute(solution);
+    std::vector<T> result(get_size());
+    for (size_t row_ = 0; row_ < get_size(); row_++) {
+        result[permutation[row_]] = solution[row_];
+    }
+    return result;
+}
+
+template <typename T>
+matrix<T> sparse_ldl_factorization<T>::solve(const matrix<T>& right_side) const {
+    if (right_side.get_row_number() != get_size())
+        throw std::runtime_error("Linear system could not be solved: right side has wrong size");
+    if (is_singular())
+        throw typename matrix<T>::ZeroDivisionException();
+
+    matrix<T> result(get_size(), right_side.get_col_number());
+    std::vector<T> solution(get_size());
+    for (size_t col_ = 0; col_ < right_side.get_col_number(); col_++) {
+        for (size_t row_ = 0; row_ < get_size(); row_++) {
+            solution[row_] = right_side[permutation[row_]][col_];
+        }
+        substitute(solution);
+        for (size_t row_ = 0; row_ < get_size(); row_++) {
+            result[permutation[row_]][col_] = solution[row_];
+        }
+    }
+    return result;
+}
+
+template <typename T>
+void sparse_ldl_factorization<T>::substitute(std::vector<T>& solution) const {
+    for (size_t column = 0; column < get_size(); column++) {
+        const T value = solution[column];
+        for (index position = factor_col_offsets[column]; position < factor_col_offsets[column + 1]; position++) {
+            solution[factor_row_indices[position]] -= factor_values[position] * value;
+        }
+    }
+    for (size_t row_ = 0; row_ < get_size(); row_++) {
+        solution[row_] /= diagonal[row_];
+    }
+    for (size_t column = get_size(); column-- > 0;) {
+        T value = solution[column];
+        for (index position = factor_col_offsets[column]; position < factor_col_offsets[column + 1]; position++) {
+            value -= factor_values[position] * solution[factor_row_indices[position]];
+        }
+        solution[column] = value;
+    }
+}
+
+#endif //CIRCUITS_SPARSE_MATRIX_H
@@ -73,4 +73,26 @@ TEST(ACCircuitTest, CalculationTest6) {
     std::string inp("1 -- 2, 12R; 0C; 0L; 100V, 0; 2 -- 3, 0R; 20C; 0L; 3 -- 1, 0R; 0C; 36L;");
     std::string answer("1 -- 2: 5 A, -53.1301;\n2 -- 3: 5 A, -53.1301;\n3 -- 1: 5 A, -53.1301;");
     generate_calculation_test(inp, answer);
-}
\ No newline at end of file
+}
+
+void generate_iterative_calculation_test(const std::string& inp) {
+    std::stringstream direct_input(inp), direct_output;
+    calculate_circuit<std::complex<double>>(direct_input, direct_output);
+
+    solver_options options;
+    options.solver = solver_options::method::iterative;
+    std::stringstream input(inp), output;
+    auto statistics = calculate_circuit<std::complex<double>>(input, output, options);
+    EXPECT_EQ(direct_output.str(), output.str());
+    for (const auto& subgraph_statistics : statistics) {
+        EXPECT_TRUE(subgraph_statistics.converged);
+    }
+}
+
+TEST(ACIterativeCalculationTest, ConsistentCalculationTest) {
+    generate_iterative_calculation_test("1 -- 2, 1R; 2C; 0L; 5V, 30; 2 -- 3, 0R; 0C; 3L; 3 -- 1, 4R; 0C; 0L;");
+}
+
+TEST(ACIterativeCalculationTest, ParallelCalculationTest) {
+    generate_iterative_calculation_test("1 -- 2, 2R; 1C; 0L; 10V, 0; 2 -- 3, 1R; 0C; 2L; 2 -- 4, 3R; 0C; 0L; 4 -- 3, 0R; 4C; 0L; 3 -- 1, 5R; 0C; 1L; 1V, 90;");
+}
@@ -0,0 +1,97 @@
+#include <gmock/gmock.h>
+
+#include "../algebraic_multigrid.h"
+
+
+
+std::pair<graph, std::vector<double>> get_grid(size_t side) {
+    graph grid;
+    std::vector<double> conductivity;
+    for (size_t row = 0; row < side; row++) {
+        for (size_t col = 0; col < side; col++) {
+            if (col + 1 < side) {
+                grid.add_edge(row * side + col, row * side + col + 1);
+                conductivity.push_back(1. + (row + col) % 3);
+            }
+            if (row + 1 < side) {
+                grid.add_edge(row * side + col, (row + 1) * side + col);
+                conductivity.push_back(2. + col % 2);
+            }
+        }
+    }
+    return {grid, conductivity};
+}
+
+std::vector<double> get_right_side(size_t size) {
+    std::vector<double> right_side(size);
+    for (size_t row = 0; row < size; row++) {
+        right_side[row] = static_cast<double>(row % 7) - 3.;
+    }
+    return right_side;
+}
+
+void expect_residual(const sparse_matrix<double>& system_matrix, const std::vector<double>& right_side,
+                     const std::vector<double>& solution, double tolerance) {
+    auto residual = system_matrix.multiply(solution);
+    for (size_t row = 0; row < right_side.size(); row++) {
+        EXPECT_NEAR(right_side[row], residual[row], tolerance);
+    }
+}
+
+TEST(AlgebraicMultigridTest, HierarchyTest) {
+    auto [grid, conductivity] = get_grid(30);
+    algebraic_multigrid<double> multigrid(grid, conductivity, 899);
+    EXPECT_GT(multigrid.get_level_number(), 2);
+    EXPECT_EQ(899, multigrid.get_level_size(0));
+    for (size_t level = 1; level < multigrid.get_level_number(); level++) {
+        EXPECT_LT(multigrid.get_level_size(level), multigrid.get_level_size(level - 1));
+    }
+}
+
+TEST(AlgebraicMultigridTest, StandaloneSolveTest) {
+    auto [grid, conductivity] = get_grid(30);
+    auto system_matrix = sparse_matrix<double>::laplacian(grid, conductivity, 899);
+    auto right_side = get_right_side(899);
+    algebraic_multigrid<double> multigrid(system_matrix);
+    auto solution = multigrid.solve(right_side, 1e-10, 200);
+    EXPECT_TRUE(multigrid.get_statistics().converged);
+    EXPECT_LE(multigrid.get_statistics().relative_residual, 1e-10);
+    expect_residual(system_matrix, right_side, solution, 1e-7);
+}
+
+TEST(AlgebraicMultigridTest, PreconditionerTest) {
+    auto [grid, conductivity] = get_grid(30);
+    auto system_matrix = sparse_matrix<double>::laplacian(grid, conductivity, 899);
+    auto right_side = get_right_side(899);
+
+    jacobi_preconditioner<double> jacobi(system_matrix);
+    conjugate_gradient<double> jacobi_solver(system_matrix, jacobi, 1e-10, 1000);
+    jacobi_solver.solve(right_side);
+
+    algebraic_multigrid<double> multigrid(grid, conductivity, 899);
+    conjugate_gradient<double> solver(system_matrix, multigrid, 1e-10, 1000);
+    auto solution = solver.solve(right_side);
+    EXPECT_TRUE(solver.get_statistics().converged);
+    EXPECT_LT(4 * solver.get_statistics().iterations, jacobi_solver.get_statistics().iterations);
+    expect_residual(system_matrix, right_side, solution, 1e-7);
+}
+
+TEST(AlgebraicMultigridTest, CoarsestLevelOnlyTest) {
+    auto [grid, conductivity] = get_grid(5);
+    auto system_matrix = sparse_matrix<double>::laplacian(grid, conductivity, 24);
+    auto right_side = get_right_side(24);
+    algebraic_multigrid<double> multigrid(system_matrix);
+    EXPECT_EQ(1, multigrid.get_level_number());
+    auto solution = multigrid.solve(right_side, 1e-12, 10);
+    EXPECT_EQ(1, multigrid.get_statistics().iterations);
+    expect_residual(system_matrix, right_side, solution, 1e-10);
+}
+
+TEST(AlgebraicMultigridTest, ZeroRightSideTest) {
+    auto [grid, conductivity] = get_grid(10);
+    algebraic_multigrid<double> multigrid(grid, conductivity, 99);
+    auto solution = multigrid.solve(std::vector<double>(99, 0.), 1e-10, 10);
+    EXPECT_TRUE(multigrid.get_statistics().converged);
+    EXPECT_EQ(0, multigrid.get_statistics().iterations);
+    EXPECT_EQ(std::vector<double>(99, 0.), solution);
+}
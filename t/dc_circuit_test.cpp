@@ -160,7 +160,7 @@ TEST(CalculationTest, FullyOpenCircuitTest) {
 
 TEST(CalculationTest, OpenCircuitDifficultTest) {
     std::string inp("1 -- 2, 4.0; 1 -- 3, 10.0; 1 -- 4, 2.0; -12.0V; 2 -- 3, 60.0; 2 -- 4, 22.0; 3 -- 4, 5.0; 4 -- 5, 1.0; 100.0V;");
-    std::string answer("1 -- 2: 0.442958 A;\n1 -- 3: 0.631499 A;\n1 -- 4: -1.07446 A;\n2 -- 3: 0.0757193 A;\n2 -- 4: 0.367239 A;\n3 -- 4: 0.707219 A;\n4 -- 5: -2.84217e-14 A;");
+    std::string answer("1 -- 2: 0.442958 A;\n1 -- 3: 0.631499 A;\n1 -- 4: -1.07446 A;\n2 -- 3: 0.0757193 A;\n2 -- 4: 0.367239 A;\n3 -- 4: 0.707219 A;\n4 -- 5: 0 A;");
     generate_calculation_test(inp, answer);
 }
 
@@ -175,10 +175,10 @@ TEST(CalculationTest, CalculationZeroResistanceDifficultTest) {
                     "5 -- 10, 0; 6 -- 7, 1; 6 -- 11, 0; 7 -- 8, 2; 7 -- 12, 2; 8 -- 9, 2; 8 -- 13, 2; 9 -- 10, 1;"
                     " 9 -- 14, 2; 10 -- 15, 0; 11 -- 12, 1; 12 -- 13, 2; 13 -- 14, 2; 14 -- 15, 1; 11 -- 16, 0.0;"
                     " 15 -- 20, 0.0; 20 -- 16, 0.0; 120 V");
-    std::string answer("1 -- 2: 20 A;\n1 -- 6: -20 A;\n2 -- 3: 20 A;\n2 -- 7: -5.83329e-09 A;\n3 -- 4: 20 A;\n"
-                       "3 -- 8: -1.06581e-14 A;\n4 -- 5: 20 A;\n4 -- 9: 5.83333e-09 A;\n5 -- 10: 20 A;\n6 -- 7: 20 A;\n"
-                       "6 -- 11: -40.0001 A;\n7 -- 8: 20 A;\n7 -- 12: -9.16673e-09 A;\n8 -- 9: 20 A;\n"
-                       "8 -- 13: -1.06581e-14 A;\n9 -- 10: 20 A;\n9 -- 14: 9.16665e-09 A;\n10 -- 15: 40 A;\n"
+    std::string answer("1 -- 2: 20 A;\n1 -- 6: -20 A;\n2 -- 3: 20 A;\n2 -- 7: -5.83335e-09 A;\n3 -- 4: 20 A;\n"
+                       "3 -- 8: -3.55271e-15 A;\n4 -- 5: 20 A;\n4 -- 9: 5.83333e-09 A;\n5 -- 10: 20 A;\n6 -- 7: 20 A;\n"
+                       "6 -- 11: -40 A;\n7 -- 8: 20 A;\n7 -- 12: -9.16665e-09 A;\n8 -- 9: 20 A;\n"
+                       "8 -- 13: 0 A;\n9 -- 10: 20 A;\n9 -- 14: 9.16667e-09 A;\n10 -- 15: 40 A;\n"
                        "11 -- 12: 20 A;\n11 -- 16: -60 A;\n12 -- 13: 20 A;\n13 -- 14: 20 A;\n14 -- 15: 20 A;\n"
                        "15 -- 20: 60 A;\n20 -- 16: 60 A;");
     generate_calculation_test(inp, answer);
@@ -198,3 +198,95 @@ TEST(CircuitThrowsZeroVerticesExceptionTest, ZeroVertexTest) {
     std::string inp("0 -- 1, 4.0; 2.0V;");
     EXPECT_THROW(circuit<double> test_circuit(inp), circuit<double>::ZeroVerticesException);
 }
+
+void generate_iterative_calculation_test(const std::string& inp, solver_options::preconditioner_type preconditioner) {
+    std::stringstream direct_input(inp), direct_output;
+    calculate_circuit<double>(direct_input, direct_output);
+
+    solver_options options;
+    options.solver = solver_options::method::iterative;
+    options.preconditioner = preconditioner;
+    std::stringstream input(inp), output;
+    auto statistics = calculate_circuit<double>(input, output, options);
+    EXPECT_EQ(direct_output.str(), output.str());
+    for (const auto& subgraph_statistics : statistics) {
+        EXPECT_TRUE(subgraph_statistics.converged);
+    }
+}
+
+TEST(IterativeCalculationTest, JacobiCalculationTest) {
+    generate_iterative_calculation_test("1 -- 2, 4.0; 1 -- 3, 10.0; 1 -- 4, 2.0; -12.0V; 2 -- 3, 60.0; 2 -- 4, 22.0; 3 -- 4, 5.0;",
+                                        solver_options::preconditioner_type::jacobi);
+}
+
+TEST(IterativeCalculationTest, IncompleteCholeskyCalculationTest) {
+    generate_iterative_calculation_test("1 -- 2, 50; -75.0V; 2 -- 3, 50; 1 -- 3, 150; 1 -- 4, 100; 100.0V; 4 -- 3, 50; 5 -- 6, 1.0; 2.0V; 6 -- 5, 1.0;",
+                                        solver_options::preconditioner_type::incomplete_cholesky);
+}
+
+TEST(IterativeCalculationTest, MultigridPreconditionerCalculationTest) {
+    generate_iterative_calculation_test("1 -- 2, 4.0; 1 -- 3, 10.0; 1 -- 4, 2.0; -12.0V; 2 -- 3, 60.0; 2 -- 4, 22.0; 3 -- 4, 5.0;",
+                                        solver_options::preconditioner_type::algebraic_multigrid);
+}
+
+TEST(IterativeCalculationTest, MultigridCalculationTest) {
+    std::string inp("1 -- 2, 50; -75.0V; 2 -- 3, 50; 1 -- 3, 150; 1 -- 4, 100; 100.0V; 4 -- 3, 50;");
+    std::stringstream direct_input(inp), direct_output;
+    calculate_circuit<double>(direct_input, direct_output);
+
+    solver_options options;
+    options.solver = solver_options::method::multigrid;
+    std::stringstream input(inp), output;
+    auto statistics = calculate_circuit<double>(input, output, options);
+    EXPECT_EQ(direct_output.str(), output.str());
+    EXPECT_TRUE(statistics.front().converged);
+}
+
+TEST(ParallelCalculationTest, ParallelSubgraphsCalculationTest) {
+    std::stringstream circuit_description;
+    size_t first_vertex = 1;
+    for (size_t subgraph_index = 0; subgraph_index < 20; subgraph_index++) {
+        const size_t vertex_number = 10 + subgraph_index;
+        for (size_t vertex = 0; vertex < vertex_number; vertex++) {
+            circuit_description << first_vertex + vertex << " -- " << first_vertex + (vertex + 1) % vertex_number <<
+                                ", " << vertex + 1 << ".0; ";
+            if (vertex % 3 == 0)
+                circuit_description << subgraph_index + 1 << ".0V; ";
+        }
+        circuit_description << first_vertex << " -- " << first_vertex + vertex_number / 2 << ", 7.0; ";
+        first_vertex += vertex_number;
+    }
+
+    solver_options serial_options;
+    serial_options.thread_number = 1;
+    std::stringstream serial_input(circuit_description.str()), serial_output;
+    calculate_circuit<double>(serial_input, serial_output, serial_options);
+
+    solver_options parallel_options;
+    parallel_options.thread_number = 4;
+    std::stringstream parallel_input(circuit_description.str()), parallel_output;
+    calculate_circuit<double>(parallel_input, parallel_output, parallel_options);
+    EXPECT_EQ(serial_output.str(), parallel_output.str());
+}
+
+TEST(CalculationTest, ArticulationVertexCalculationTest) {
+    std::string inp("1 -- 2, 1.0; 6.0V; 2 -- 3, 2.0; 3 -- 1, 3.0; 3 -- 4, 1.0; 4 -- 5, 1.0; 5 -- 3, 1.0; 5 -- 6, 1.0; 2.0V;");
+    std::string answer("1 -- 2: 1 A;\n2 -- 3: 1 A;\n3 -- 1: 1 A;\n3 -- 4: 0 A;\n4 -- 5: 0 A;\n5 -- 3: 0 A;\n5 -- 6: 0 A;");
+    generate_calculation_test(inp, answer);
+}
+
+TEST(CalculationTest, ZeroResistanceLargeResistancesBridgeTest) {
+    std::stringstream input("1 -- 2, 10000000; 10V; 1 -- 3, 10000000; 1 -- 4, 10000000; 2 -- 3, 0; "
+                            "2 -- 4, 10000000; 3 -- 4, 10000000;"), output;
+    ASSERT_NO_THROW(calculate_circuit<double>(input, output));
+    // The current of the zero resistance branch is dominated by rounding
+    EXPECT_NE(std::string::npos, output.str().find("1 -- 2: 6.43365e-07 A;\n1 -- 3: -3.56635e-07 A;\n"
+                                                   "1 -- 4: -2.8673e-07 A;\n"));
+    EXPECT_NE(std::string::npos, output.str().find("2 -- 4: 6.99051e-08 A;\n3 -- 4: 6.99051e-08 A;"));
+}
+
+TEST(CalculationTest, SparseVertexLabelsCalculationTest) {
+    std::string inp("5000000 -- 7, 4.0; 5000000 -- 30, 10.0; 5000000 -- 4000, 2.0; -12.0V; 7 -- 30, 60.0; 7 -- 4000, 22.0; 30 -- 4000, 5.0; 9 -- 9, 2.0; 3.0V;");
+    std::string answer("9 -- 9: 1.5 A;\n7 -- 30: 0.0757193 A;\n7 -- 4000: 0.367239 A;\n30 -- 4000: 0.707219 A;\n5000000 -- 7: 0.442958 A;\n5000000 -- 30: 0.631499 A;\n5000000 -- 4000: -1.07446 A;");
+    generate_calculation_test(inp, answer);
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+
+#include "../element_library.h"
+
+static const std::string Library_source =
+        "define ThreePhase(A, B, C, N)\n internal Z\n Z -- A, 0R; 0C; 0L; 220V, 0\n"
+        " Z -- B, 0R; 0C; 0L; 220V, 120\n Z -- C, 0R; 0C; 0L; 220V, -120\n Z -- N, 0R; 0C; 0L;\n"
+        "define Load(A, B)\n A -- B, 10R; 2C; 5L;\n"
+        "define Empty()\n";
+
+static void compile_library(const std::string& source, const std::string& file_name) {
+    std::istringstream input(source);
+    std::ofstream output(file_name, std::ios::binary);
+    element_library::compile(input, "input", output);
+}
+
+static void write_file(const std::string& file_name, const std::string& content) {
+    std::ofstream file(file_name, std::ios::binary);
+    file << content;
+}
+
+TEST(ElementLibraryTest, CompileTest) {
+    compile_library(Library_source, "library.bin");
+    element_library library("library.bin");
+    EXPECT_EQ(3, library.get_element_number());
+    EXPECT_EQ(std::vector<std::string>({"Empty", "Load", "ThreePhase"}), library.get_element_names());
+    EXPECT_TRUE(library.contains("Load"));
+    EXPECT_FALSE(library.contains("Unknown"));
+
+    std::istringstream input(Library_source);
+    input_preworker preworker(input, "input", 0);
+    preworker.perform_prework();
+    const auto& expected_element = preworker.get_elements().at("ThreePhase");
+    input_preworker::element element_;
+    ASSERT_TRUE(library.find_element("ThreePhase", element_));
+    EXPECT_EQ(expected_element.name, element_.name);
+    EXPECT_EQ(expected_element.parameters, element_.parameters);
+    EXPECT_EQ(expected_element.internal_variables, element_.internal_variables);
+    EXPECT_EQ(expected_element.variables, element_.variables);
+    EXPECT_EQ(expected_element.edges, element_.edges);
+    ASSERT_EQ(expected_element.compiled_edges.size(), element_.compiled_edges.size());
+    for (size_t edge = 0; edge < element_.compiled_edges.size(); edge++) {
+        EXPECT_EQ(expected_element.compiled_edges[edge].outcoming_slot, element_.compiled_edges[edge].outcoming_slot);
+        EXPECT_EQ(expected_element.compiled_edges[edge].incoming_slot, element_.compiled_edges[edge].incoming_slot);
+        EXPECT_EQ(expected_element.compiled_edges[edge].resistance, element_.compiled_edges[edge].resistance);
+        EXPECT_EQ(expected_element.compiled_edges[edge].emf, element_.compiled_edges[edge].emf);
+    }
+}
+
+TEST(ElementLibraryTest, IncludeLibraryTest) {
+    write_file("library.txt", Library_source);
+    compile_library(Library_source, "library.bin");
+    const std::string netlist = "ThreePhase(1, 2, 3, 4)\nLoad(2, 5)\nEmpty()\nThreePhase(5, 6, 7, 8)\n";
+    std::istringstream text_input("include library.txt\n" + netlist);
+    input_preworker text_preworker(text_input, "input", 0);
+    text_preworker.perform_prework();
+    std::istringstream library_input("include library.bin\n" + netlist);
+    input_preworker library_preworker(library_input, "input", 0);
+    library_preworker.perform_prework();
+    EXPECT_EQ(text_preworker.get_output(), library_preworker.get_output());
+    EXPECT_EQ(9, library_preworker.get_edges().size());
+    EXPECT_EQ(10, library_preworker.get_edges().back().outcoming_vertex);
+}
+
+TEST(ElementLibraryTest, IncludedLibraryCompileTest) {
+    compile_library(Library_source, "library.bin");
+    compile_library("include library.bin\ndefine Pair(A, B)\n A -- B, 1R; 0C; 0L;\n", "pair.bin");
+    element_library library("pair.bin");
+    EXPECT_EQ(std::vector<std::string>({"Empty", "Load", "Pair", "ThreePhase"}), library.get_element_names());
+}
+
+TEST(ElementLibraryTest, MultipleDefinitionTest) {
+    compile_library(Library_source, "library.bin");
+    std::istringstream input("include library.bin\ndefine Load(A, B)\n A -- B, 1R; 0C; 0L;\n");
+    input_preworker preworker(input, "input", 0);
+    EXPECT_THROW(preworker.perform_prework(), input_preworker::MultipleDefinitionException);
+}
+
+TEST(ElementLibraryTest, DefinitionBeforeIncludeTest) {
+    compile_library(Library_source, "library.bin");
+    std::istringstream input("define Load(A, B)\n A -- B, 1R; 0C; 0L;\ninclude library.bin\nLoad(1, 2)\n");
+    input_preworker preworker(input, "input", 0);
+    EXPECT_THROW(preworker.perform_prework(), input_preworker::MultipleDefinitionException);
+}
+
+TEST(ElementLibraryTest, TwoLibrariesTest) {
+    compile_library(Library_source, "library.bin");
+    compile_library("define Load(A, B)\n A -- B, 1R; 0C; 0L;\n", "load.bin");
+    std::istringstream input("include library.bin\nLoad(1, 2)\ninclude load.bin\nLoad(1, 2)\n");
+    input_preworker preworker(input, "input", 0);
+    EXPECT_THROW(preworker.perform_prework(), input_preworker::MultipleDefinitionException);
+}
+
+TEST(ElementLibraryTest, UnknownElementTest) {
+    compile_library(Library_source, "library.bin");
+    std::istringstream input("include library.bin\nUnknown(1, 2)\n");
+    input_preworker preworker(input, "input", 0);
+    EXPECT_THROW(preworker.perform_prework(), input_preworker::UnknownElementException);
+}
+
+TEST(ElementLibraryTest, NotOnlyDefinitionsTest) {
+    std::istringstream input("define Load(A, B)\n A -- B, 1R; 0C; 0L;\nLoad(1, 2)\n");
+    std::ostringstream output;
+    EXPECT_THROW(element_library::compile(input, "input", output), element_library::NotOnlyDefinitionsException);
+}
+
+TEST(ElementLibraryTest, InvalidLibraryTest) {
+    compile_library(Library_source, "library.bin");
+    std::ifstream file("library.bin", std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    write_file("broken.bin", content.substr(0, content.size() / 2));
+    EXPECT_THROW(element_library("broken.bin"), element_library::InvalidLibraryException);
+
+    content[8]++;
+    write_file("broken.bin", content);
+    EXPECT_THROW(element_library("broken.bin"), element_library::InvalidLibraryException);
+    std::istringstream input("include broken.bin\n");
+    input_preworker preworker(input, "input", 0);
+    EXPECT_THROW(preworker.perform_prework(), element_library::InvalidLibraryException);
+}
@@ -87,4 +87,103 @@ TEST(GraphConnectivityTest, CoherentSmallGraphTest) {
     graph test_graph;
     test_graph.add_edge(0, 0);
     EXPECT_NO_THROW(test_graph.check_connectivity());
-}
\ No newline at end of file
+}
+
+TEST(BiconnectedComponentsTest, ArticulationVertexTest) {
+    graph test_graph;
+    test_graph.add_edge(0, 1);
+    test_graph.add_edge(1, 2);
+    test_graph.add_edge(2, 0);
+    test_graph.add_edge(2, 3);
+    test_graph.add_edge(3, 4);
+    test_graph.add_edge(4, 2);
+    test_graph.add_edge(4, 5);
+    std::vector<graph::edges> expected_components = {{0, 1, 2}, {3, 4, 5}, {6}};
+    EXPECT_EQ(expected_components, test_graph.get_biconnected_components());
+}
+
+TEST(BiconnectedComponentsTest, ParallelEdgesTest) {
+    graph test_graph;
+    test_graph.add_edge(0, 1);
+    test_graph.add_edge(1, 0);
+    test_graph.add_edge(1, 2);
+    std::vector<graph::edges> expected_components = {{0, 1}, {2}};
+    EXPECT_EQ(expected_components, test_graph.get_biconnected_components());
+}
+
+TEST(BiconnectedComponentsTest, EdgesSubgraphTest) {
+    graph test_graph;
+    test_graph.add_edge(0, 1);
+    test_graph.add_edge(1, 2);
+    test_graph.add_edge(2, 3);
+    test_graph.add_edge(3, 1);
+    auto subgraph = test_graph.get_edges_subgraph({1, 2, 3});
+    EXPECT_EQ(3, subgraph.get_edge_number());
+    EXPECT_EQ(3, subgraph.get_vertex_number());
+    auto expected_vertices = std::pair<graph::vertex, graph::vertex>(2, 0);
+    EXPECT_EQ(expected_vertices, subgraph.get_tied_vertices(2));
+}
+
+TEST(CoherentSubgraphsTest, SubgraphsOrderTest) {
+    graph test_graph;
+    test_graph.add_edge(4, 0);
+    test_graph.add_edge(1, 3);
+    test_graph.add_edge(0, 2);
+    test_graph.add_edge(3, 5);
+    auto subgraphs = test_graph.get_coherent_subgraphs();
+    ASSERT_EQ(2, subgraphs.size());
+    EXPECT_EQ(3, subgraphs.get_vertex_number(0));
+    EXPECT_EQ(3, subgraphs.get_vertex_number(1));
+    EXPECT_EQ(2, subgraphs.get_edge(0, 0));
+    EXPECT_EQ(0, subgraphs.get_edge(0, 1));
+    EXPECT_EQ(1, subgraphs.get_edge(1, 0));
+    EXPECT_EQ(3, subgraphs.get_edge(1, 1));
+    EXPECT_EQ(4, subgraphs.get_vertex(0, 2));
+    EXPECT_EQ(1, subgraphs.get_vertex_subgraph(5));
+    EXPECT_EQ(2, subgraphs.get_subgraph_vertex(5));
+    EXPECT_EQ(1, subgraphs.get_edge_subgraph(3));
+    EXPECT_EQ(1, subgraphs.get_subgraph_edge(3));
+}
+
+TEST(CoherentSubgraphsTest, IsolatedVertexTest) {
+    graph test_graph;
+    test_graph.add_edge(0, 1);
+    test_graph.add_edge(3, 2);
+    test_graph.add_edge(4, 4);
+    auto subgraphs = test_graph.get_coherent_subgraphs();
+    ASSERT_EQ(3, subgraphs.size());
+    EXPECT_EQ(0, subgraphs.get_edge_number(2));
+    EXPECT_EQ(1, subgraphs.get_edge_subgraph(1));
+    EXPECT_EQ(2, subgraphs.get_vertex_subgraph(4));
+    EXPECT_EQ(1, subgraphs.get_edge(1, 0));
+}
+
+TEST(GraphConnectivityTest, LongChainTest) {
+    const size_t vertex_number = 200000;
+    graph test_graph;
+    for (graph::vertex vertex = 0; vertex + 1 < vertex_number; vertex++) {
+        test_graph.add_edge(vertex, vertex + 1);
+    }
+    EXPECT_NO_THROW(test_graph.check_connectivity());
+    EXPECT_EQ(vertex_number - 1, test_graph.get_biconnected_components().size());
+}
+
+TEST(AddEdgeTest, AdjacencyRebuildTest) {
+    graph test_graph;
+    test_graph.add_edge(0, 1);
+    test_graph.add_edge(2, 1);
+    EXPECT_EQ(2, test_graph.get_incoming_edges(1).size());
+    EXPECT_EQ(2, test_graph.get_vertex_degree(1));
+    test_graph.add_edge(1, 3);
+    test_graph.add_edge(4, 4);
+    EXPECT_EQ(5, test_graph.get_vertex_number());
+    EXPECT_EQ(3, test_graph.get_vertex_degree(1));
+    EXPECT_EQ(2, test_graph.get_outcoming_edges(1)[0]);
+    EXPECT_TRUE(test_graph.get_outcoming_edges(4).empty());
+}
+
+TEST(GraphTest, IdOverflowTest) {
+    graph test_graph;
+    EXPECT_THROW(test_graph.add_edge(0, std::numeric_limits<graph::vertex>::max()), graph::IdOverflowException);
+    EXPECT_NO_THROW(test_graph.add_edge(0, std::numeric_limits<graph::vertex>::max() - 1));
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <fstream>
 
 #include "../input_parser.h"
 #include "../complex_number.h"
@@ -401,4 +402,51 @@ TEST(ParserThrowsInvalidInputExceptionTest, UnexpectedCharacterAfterAcEMFPhaseTe
     input_parser parser("1 -- 2, 0.1R; 0.2C; 0.3L; 0.5V 5a;");
     parser.make_iteration();
     EXPECT_THROW(parser.make_iteration(), input_parser::InvalidInputException);
-}
\ No newline at end of file
+}
+
+TEST(ParserThrowsInvalidInputExceptionTest, UnexpectedCharacterPositionTest) {
+    input_parser parser("1 -- 2, 0.1;\n2 -- 3, 0.2;\n3 -- 4, 0.3a;");
+    parser.make_iteration();
+    parser.make_iteration();
+    try {
+        parser.make_iteration();
+        parser.make_iteration();
+        FAIL();
+    } catch (const input_parser::InvalidInputException& exception) {
+        EXPECT_EQ(3, exception.get_line());
+        EXPECT_EQ(12, exception.get_column());
+    }
+}
+
+TEST(DcInputTest, MultilineInputTest) {
+    input_parser parser("1 -- 2, 0.1;\r\n1 -- 3, 2e-1; 5V;\n\t2 -- 3, 0.3;\n");
+    std::vector<input_parser::state> states;
+    while (!parser.is_eof()) {
+        parser.make_iteration();
+        states.emplace_back(parser.get_current_edge_info());
+    }
+    ASSERT_EQ(3, states.size());
+    EXPECT_EQ(1, states[1].outcoming_vertex);
+    EXPECT_EQ(3, states[1].incoming_vertex);
+    EXPECT_EQ(std::complex<double>(0.2), states[1].resistance);
+    EXPECT_EQ(std::complex<double>(5.), states[1].emf);
+    EXPECT_EQ(2, states[2].outcoming_vertex);
+    EXPECT_EQ(std::complex<double>(0.3), states[2].resistance);
+    EXPECT_FALSE(parser.is_emf_included());
+}
+
+TEST(MappedInputTest, ReadFileTest) {
+    const std::string file_name = testing::TempDir() + "mapped_input_test.txt";
+    std::ofstream(file_name) << "1 -- 2, 0.1; 0.5V;\n";
+    mapped_input input(file_name);
+    EXPECT_EQ("1 -- 2, 0.1; 0.5V;\n", input.get_view());
+    input_parser parser(input.get_view());
+    parser.make_iteration();
+    EXPECT_EQ(std::complex<double>(0.5), parser.get_current_edge_info().emf);
+    EXPECT_TRUE(parser.is_eof());
+    std::remove(file_name.c_str());
+}
+
+TEST(MappedInputTest, MissingFileTest) {
+    EXPECT_THROW(mapped_input("missing_mapped_input_test.txt"), mapped_input::FileOpenException);
+}
@@ -76,6 +76,14 @@ TEST(TokenizerTest, IncludeTest) {
     EXPECT_EQ(preworker.get_tokens(), expected_tokens);
 }
 
+TEST(TokenizerTest, SignedValuesTest) {
+    std::istringstream input("+3 --\t04 , 1R;-2C; 3L; 220V, -120\nFunction(+1, 02)\n");
+    input_preworker preworker(input, "input", 0);
+    std::vector<std::vector<std::string>> expected_tokens{{"3", "4", "1R", "-2C", "3L", "220V", "-120"},
+                                                          {"Function", "1", "2"}};
+    EXPECT_EQ(preworker.get_tokens(), expected_tokens);
+}
+
 TEST(PreworkerTest, DefineTest) {
     std::istringstream input("define Function(A,B)\n A--B, 0R; 0C; 0L;\nFunction(1,2)");
     input_preworker preworker(input, "input", 0);
@@ -427,6 +435,12 @@ TEST(InvalidInputTest, InvalidElementEdge19Test) {
     EXPECT_THROW(input_preworker(input, "input", 0), input_preworker::UnexpectedTokenException);
 }
 
+TEST(InvalidInputTest, InvalidElementEdge20Test) {
+    std::istringstream input("1--2, 0R; 0C; 0L;\n A -- B, 0R; 0C; 0L;\n");
+    input_preworker preworker(input, "input", 0, false);
+    EXPECT_THROW(preworker.perform_prework(), input_preworker::UnexpectedTokenException);
+}
+
 TEST(InvalidInputTest, InvalidEdge1Test) {
     std::istringstream input("1 - 2, 0R; 0C; 0L;");
     EXPECT_THROW(input_preworker(input, "input", 0), input_preworker::UnexpectedTokenException);
@@ -542,3 +556,181 @@ TEST(FilePathTest, FilePathTest) {
     std::istringstream input("include a a");
     EXPECT_THROW(input_preworker(input, "../test.txt", 0), input_preworker::UnexpectedTokenException);
 }
+
+TEST(EdgeRecordsTest, ElementEdgesTest) {
+    std::istringstream input("define Function(A,B)\n internal Z\n A--Z, 1R; 2C; 3L; 5V, 90;\n Z--B, 4R; 0C; 0L;\n"
+                             "Function(1,2)\n2--1, 0.5R; 0C; 1.5L;");
+    input_preworker preworker(input, "input", 0, false);
+    preworker.perform_prework();
+    EXPECT_EQ(preworker.get_output(), "");
+    const auto& edges = preworker.get_edges();
+    ASSERT_EQ(3, edges.size());
+    EXPECT_EQ(1, edges[0].outcoming_vertex);
+    EXPECT_EQ(3, edges[0].incoming_vertex);
+    EXPECT_EQ(std::complex<double>(1., 1.), edges[0].resistance);
+    EXPECT_EQ(std::polar(5., -M_PI / 2), edges[0].emf);
+    EXPECT_EQ(3, edges[1].outcoming_vertex);
+    EXPECT_EQ(2, edges[1].incoming_vertex);
+    EXPECT_EQ(std::complex<double>(4.), edges[1].resistance);
+    EXPECT_EQ(std::complex<double>(0.), edges[1].emf);
+    EXPECT_EQ(2, edges[2].outcoming_vertex);
+    EXPECT_EQ(1, edges[2].incoming_vertex);
+    EXPECT_EQ(std::complex<double>(0.5, 1.5), edges[2].resistance);
+}
+
+TEST(EdgeRecordsTest, IncludeEdgesTest) {
+    std::ofstream file_to_include;
+    file_to_include.open("test.txt");
+    file_to_include << "define Function(A,B)\n A--B, 2R; 0C; 0L;\n1--2, 1R; 0C; 0L;";
+    file_to_include.close();
+    std::istringstream input("include test.txt\nFunction(3,4)");
+    input_preworker preworker(input, "input", 0);
+    preworker.perform_prework();
+    EXPECT_EQ(preworker.get_output(), "1 2 1R 0C 0L \n3 4 2R 0C 0L \n");
+    const auto& edges = preworker.get_edges();
+    ASSERT_EQ(2, edges.size());
+    EXPECT_EQ(1, edges[0].outcoming_vertex);
+    EXPECT_EQ(std::complex<double>(1.), edges[0].resistance);
+    EXPECT_EQ(3, edges[1].outcoming_vertex);
+    EXPECT_EQ(4, edges[1].incoming_vertex);
+    EXPECT_EQ(std::complex<double>(2.), edges[1].resistance);
+}
+
+static std::string get_three_phase_netlist(size_t element_number) {
+    std::stringstream netlist;
+    netlist << "define ThreePhase(A, B, C, N)\n internal Z\n Z -- A, 0R; 0C; 0L; 220V, 0\n"
+               " Z -- B, 0R; 0C; 0L; 220V, 120\n Z -- C, 0R; 0C; 0L; 220V, -120\n Z -- N, 0R; 0C; 0L;\n";
+    for (size_t element = 0; element < element_number; element++) {
+        netlist << "ThreePhase(" << 4 * element + 1 << ", " << 4 * element + 2 << ", " << 4 * element + 3 << ", "
+                << 4 * element + 4 << ")\n";
+        if (element % 7 == 0)
+            netlist << 4 * element + 2 << " -- " << 4 * element + 3 << ", 5R; 0C; 0L;\n\n";
+    }
+    netlist << "define Bridge(A, B)\n internal M\n A -- M, 1R; 0C; 0L;\n M -- B, 1R; 0.5C; 0.2L;\n";
+    for (size_t element = 1; element < element_number; element++) {
+        netlist << "Bridge(" << 4 * element << ", " << 4 * element + 1 << ")\n";
+    }
+    return netlist.str();
+}
+
+TEST(ParallelExpansionTest, SequentialNumberingTest) {
+    const auto netlist = get_three_phase_netlist(3000);
+    std::istringstream sequential_input(netlist);
+    input_preworker sequential_preworker(sequential_input, "input", 0, true, 1);
+    sequential_preworker.perform_prework();
+    std::istringstream parallel_input(netlist);
+    input_preworker parallel_preworker(parallel_input, "input", 0, false, 4);
+    parallel_preworker.perform_prework();
+
+    const auto& expected_edges = sequential_preworker.get_edges();
+    const auto& edges = parallel_preworker.get_edges();
+    ASSERT_EQ(expected_edges.size(), edges.size());
+    for (size_t edge = 0; edge < edges.size(); edge++) {
+        EXPECT_EQ(expected_edges[edge].outcoming_vertex, edges[edge].outcoming_vertex);
+        EXPECT_EQ(expected_edges[edge].incoming_vertex, edges[edge].incoming_vertex);
+        EXPECT_EQ(expected_edges[edge].resistance, edges[edge].resistance);
+        EXPECT_EQ(expected_edges[edge].emf, edges[edge].emf);
+    }
+    EXPECT_EQ(12000 + 3000 + 2999, edges.back().outcoming_vertex);
+}
+
+TEST(ParallelExpansionTest, InvalidVertexTest) {
+    auto netlist = get_three_phase_netlist(2000);
+    netlist += "Bridge(1, -2)\nUnknown(1, 2)\n";
+    std::istringstream input(netlist);
+    input_preworker preworker(input, "input", 0, false, 4);
+    EXPECT_THROW(preworker.perform_prework(), input_preworker::UnexpectedTokenException);
+}
+
+TEST(ParallelExpansionTest, UnknownElementTest) {
+    auto netlist = get_three_phase_netlist(2000);
+    netlist += "Unknown(1, 2)\nBridge(1, -2)\n";
+    std::istringstream input(netlist);
+    input_preworker preworker(input, "input", 0, false, 4);
+    EXPECT_THROW(preworker.perform_prework(), input_preworker::UnknownElementException);
+}
+
+static void write_file(const std::string& file_name, const std::string& content) {
+    std::ofstream file(file_name);
+    file << content;
+}
+
+TEST(IncludeCacheTest, DiamondIncludeTest) {
+    write_file("library.txt", "define Function(A,B)\n A--B, 1R; 0C; 0L;");
+    write_file("first.txt", "include library.txt\nFunction(1,2)");
+    write_file("second.txt", "include library.txt\nFunction(3,4)");
+    std::istringstream input("include first.txt\ninclude second.txt\nFunction(5,6)");
+    input_preworker preworker(input, "input", 0);
+    preworker.perform_prework();
+    EXPECT_EQ(preworker.get_output(), "1 2 1R 0C 0L \n3 4 1R 0C 0L \n5 6 1R 0C 0L \n");
+}
+
+TEST(IncludeCacheTest, RepeatedIncludeTest) {
+    write_file("edges.txt", "1 -- 2, 1R; 0C; 0L; 10V, 0;\ndefine Function(A,B)\n A--B, 1R; 0C; 0L;");
+    std::istringstream input("include edges.txt\ninclude edges.txt\n2 -- 1, 1R; 0C; 0L;\nFunction(3,4)");
+    input_preworker preworker(input, "input", 0);
+    preworker.perform_prework();
+    EXPECT_EQ(preworker.get_output(), "1 2 1R 0C 0L 10V 0 \n1 2 1R 0C 0L 10V 0 \n2 1 1R 0C 0L \n3 4 1R 0C 0L \n");
+    EXPECT_EQ(4, preworker.get_edges().size());
+}
+
+TEST(IncludeCacheTest, CyclicIncludeTest) {
+    write_file("first.txt", "include second.txt\ndefine First(A,B)\n A--B, 1R; 0C; 0L;");
+    write_file("second.txt", "include first.txt\ndefine Second(A,B)\n A--B, 2R; 0C; 0L;");
+    std::istringstream input("include first.txt\nFirst(1,2)\nSecond(2,3)");
+    input_preworker preworker(input, "input", 0);
+    preworker.perform_prework();
+    EXPECT_EQ(preworker.get_output(), "1 2 1R 0C 0L \n2 3 2R 0C 0L \n");
+}
+
+TEST(IncludeCacheTest, UnusedElementTest) {
+    write_file("library.txt", "define Broken(A,B)\n A--C, 1R; 0C; 0L;\ndefine Function(A,B)\n A--B, 1R; 0C; 0L;");
+    std::istringstream input("include library.txt\nFunction(1,2)");
+    input_preworker preworker(input, "input", 0);
+    preworker.perform_prework();
+    EXPECT_EQ(1, preworker.get_elements().size());
+    EXPECT_EQ(1, preworker.get_elements().count("Function"));
+
+    std::istringstream broken_input("include library.txt\nBroken(1,2)");
+    input_preworker broken_preworker(broken_input, "input", 0);
+    EXPECT_THROW(broken_preworker.perform_prework(), input_preworker::UndefinedVariableException);
+}
+
+TEST(IncludeCacheTest, DefinitionErrorOrderTest) {
+    write_file("library.txt", "define Good(A,B)\n A--B, 1R; 0C; 0L;\ndefine Broken(A,B)\n A--C, 1R; 0C; 0L;");
+    for (bool is_text_output : {true, false}) {
+        std::istringstream input("include library.txt\nGood(1, -2)\nBroken(3, 4)");
+        input_preworker preworker(input, "input", 0, is_text_output, 4);
+        EXPECT_THROW(preworker.perform_prework(), input_preworker::UnexpectedTokenException);
+    }
+}
+
+TEST(IncludeCacheTest, ParallelLoadingTest) {
+    std::stringstream netlist;
+    for (size_t file = 0; file < 16; file++) {
+        const std::string file_name = "library" + std::to_string(file) + ".txt";
+        std::stringstream library;
+        if (file > 0)
+            library << "include library" << (file - 1) / 2 << ".txt\n";
+        library << "define Element" << file << "(A, B)\n internal M\n A -- M, " << file << "R; 0C; 0L;\n"
+                << " M -- B, 1R; 0C; 0L;\n" << file + 1 << " -- " << file + 2 << ", 1R; 0C; 0L;\n";
+        write_file(file_name, library.str());
+        netlist << "include " << file_name << "\nElement" << file << "(" << file + 1 << ", 1)\n";
+    }
+    std::istringstream sequential_input(netlist.str());
+    input_preworker sequential_preworker(sequential_input, "input", 0, true, 1);
+    sequential_preworker.perform_prework();
+    std::istringstream parallel_input(netlist.str());
+    input_preworker parallel_preworker(parallel_input, "input", 0, true, 4);
+    parallel_preworker.perform_prework();
+    EXPECT_EQ(sequential_preworker.get_output(), parallel_preworker.get_output());
+    // Plain edges are expanded on every include, including a library of depth d expands d + 1 of them
+    EXPECT_EQ(16 * 2 + 1 + 2 * 2 + 4 * 3 + 8 * 4 + 5, parallel_preworker.get_edges().size());
+}
+
+TEST(IncludeCacheTest, MissingNestedIncludeTest) {
+    write_file("first.txt", "include missing.txt\n");
+    std::istringstream input("include first.txt");
+    input_preworker preworker(input, "input", 0, false, 4);
+    EXPECT_THROW(preworker.perform_prework(), input_preworker::FileOpenException);
+}
@@ -0,0 +1,192 @@
+#include <gmock/gmock.h>
+
+#include "../iterative_solver.h"
+
+
+
+sparse_matrix<double> get_grid_laplacian(size_t side) {
+    graph grid;
+    std::vector<double> weights;
+    for (size_t row = 0; row < side; row++) {
+        for (size_t col = 0; col < side; col++) {
+            if (col + 1 < side) {
+                grid.add_edge(row * side + col, row * side + col + 1);
+                weights.push_back(1. + (row + col) % 3);
+            }
+            if (row + 1 < side) {
+                grid.add_edge(row * side + col, (row + 1) * side + col);
+                weights.push_back(2. + col % 2);
+            }
+        }
+    }
+    return sparse_matrix<double>::laplacian(grid, weights, side * side - 1);
+}
+
+std::vector<double> get_right_side(size_t size) {
+    std::vector<double> right_side(size);
+    for (size_t row = 0; row < size; row++) {
+        right_side[row] = static_cast<double>(row % 7) - 3.;
+    }
+    return right_side;
+}
+
+void expect_solution(const sparse_matrix<double>& system_matrix, const std::vector<double>& right_side,
+                     const std::vector<double>& solution) {
+    auto expected = system_matrix.factorize().solve(right_side);
+    for (size_t row = 0; row < solution.size(); row++) {
+        EXPECT_NEAR(expected[row], solution[row], 1e-7);
+    }
+}
+
+TEST(ConjugateGradientTest, JacobiPreconditionerTest) {
+    auto system_matrix = get_grid_laplacian(10);
+    auto right_side = get_right_side(system_matrix.get_row_number());
+    jacobi_preconditioner<double> system_preconditioner(system_matrix);
+    conjugate_gradient<double> solver(system_matrix, system_preconditioner, 1e-12, 1000);
+    auto solution = solver.solve(right_side);
+    EXPECT_TRUE(solver.get_statistics().converged);
+    EXPECT_LE(solver.get_statistics().relative_residual, 1e-12);
+    expect_solution(system_matrix, right_side, solution);
+}
+
+TEST(ConjugateGradientTest, IncompleteCholeskyPreconditionerTest) {
+    auto system_matrix = get_grid_laplacian(10);
+    auto right_side = get_right_side(system_matrix.get_row_number());
+    jacobi_preconditioner<double> jacobi(system_matrix);
+    conjugate_gradient<double> jacobi_solver(system_matrix, jacobi, 1e-12, 1000);
+    jacobi_solver.solve(right_side);
+
+    incomplete_cholesky_preconditioner<double> system_preconditioner(system_matrix);
+    conjugate_gradient<double> solver(system_matrix, system_preconditioner, 1e-12, 1000);
+    auto solution = solver.solve(right_side);
+    EXPECT_TRUE(solver.get_statistics().converged);
+    EXPECT_LT(solver.get_statistics().iterations, jacobi_solver.get_statistics().iterations);
+    expect_solution(system_matrix, right_side, solution);
+}
+
+TEST(ConjugateGradientTest, ExactIncompleteCholeskyTest) {
+    graph chain;
+    for (size_t vertex = 0; vertex + 1 < 20; vertex++) {
+        chain.add_edge(vertex, vertex + 1);
+    }
+    auto system_matrix = sparse_matrix<double>::laplacian(chain, std::vector<double>(19, 2.), 19);
+    auto right_side = get_right_side(19);
+    incomplete_cholesky_preconditioner<double> system_preconditioner(system_matrix);
+    conjugate_gradient<double> solver(system_matrix, system_preconditioner, 1e-12, 100);
+    auto solution = solver.solve(right_side);
+    EXPECT_EQ(1, solver.get_statistics().iterations);
+    expect_solution(system_matrix, right_side, solution);
+}
+
+TEST(ConjugateGradientTest, ZeroRightSideTest) {
+    auto system_matrix = get_grid_laplacian(3);
+    jacobi_preconditioner<double> system_preconditioner(system_matrix);
+    conjugate_gradient<double> solver(system_matrix, system_preconditioner, 1e-12, 100);
+    auto solution = solver.solve(std::vector<double>(system_matrix.get_row_number(), 0.));
+    EXPECT_TRUE(solver.get_statistics().converged);
+    EXPECT_EQ(0, solver.get_statistics().iterations);
+    EXPECT_EQ(std::vector<double>(system_matrix.get_row_number(), 0.), solution);
+}
+
+TEST(ConjugateGradientTest, IterationLimitTest) {
+    auto system_matrix = get_grid_laplacian(10);
+    jacobi_preconditioner<double> system_preconditioner(system_matrix);
+    conjugate_gradient<double> solver(system_matrix, system_preconditioner, 1e-12, 3);
+    solver.solve(get_right_side(system_matrix.get_row_number()));
+    EXPECT_FALSE(solver.get_statistics().converged);
+    EXPECT_EQ(3, solver.get_statistics().iterations);
+    EXPECT_GT(solver.get_statistics().relative_residual, 1e-12);
+}
+
+TEST(ConjugateGradientTest, WrongRightSideTest) {
+    auto system_matrix = get_grid_laplacian(3);
+    jacobi_preconditioner<double> system_preconditioner(system_matrix);
+    conjugate_gradient<double> solver(system_matrix, system_preconditioner, 1e-12, 100);
+    EXPECT_THROW(solver.solve(std::vector<double>(2, 1.)), std::runtime_error);
+}
+
+sparse_matrix<std::complex<double>> get_complex_grid_laplacian(size_t side) {
+    graph grid;
+    std::vector<std::complex<double>> weights;
+    for (size_t row = 0; row < side; row++) {
+        for (size_t col = 0; col < side; col++) {
+            if (col + 1 < side) {
+                grid.add_edge(row * side + col, row * side + col + 1);
+                weights.emplace_back(1., (row + col) % 3 - 1.);
+            }
+            if (row + 1 < side) {
+                grid.add_edge(row * side + col, (row + 1) * side + col);
+                weights.emplace_back(2., col % 2 ? 1. : -0.5);
+            }
+        }
+    }
+    return sparse_matrix<std::complex<double>>::laplacian(grid, weights, side * side - 1);
+}
+
+std::vector<std::complex<double>> get_complex_right_side(size_t size) {
+    std::vector<std::complex<double>> right_side(size);
+    for (size_t row = 0; row < size; row++) {
+        right_side[row] = {static_cast<double>(row % 5) - 2., static_cast<double>(row % 3)};
+    }
+    return right_side;
+}
+
+void expect_complex_solution(const sparse_matrix<std::complex<double>>& system_matrix,
+                             const std::vector<std::complex<double>>& right_side,
+                             const std::vector<std::complex<double>>& solution) {
+    auto residual = system_matrix.multiply(solution);
+    for (size_t row = 0; row < solution.size(); row++) {
+        EXPECT_NEAR(0., std::abs(right_side[row] - residual[row]), 1e-8);
+    }
+}
+
+TEST(ConjugateOrthogonalGradientTest, ComplexSymmetricTest) {
+    auto system_matrix = get_complex_grid_laplacian(8);
+    auto right_side = get_complex_right_side(system_matrix.get_row_number());
+    incomplete_lu_preconditioner<std::complex<double>> system_preconditioner(system_matrix);
+    conjugate_gradient<std::complex<double>> solver(system_matrix, system_preconditioner, 1e-12, 1000);
+    auto solution = solver.solve(right_side);
+    EXPECT_TRUE(solver.get_statistics().converged);
+    expect_complex_solution(system_matrix, right_side, solution);
+}
+
+TEST(BiconjugateGradientStabilizedTest, ComplexSymmetricTest) {
+    auto system_matrix = get_complex_grid_laplacian(8);
+    auto right_side = get_complex_right_side(system_matrix.get_row_number());
+    jacobi_preconditioner<std::complex<double>> system_preconditioner(system_matrix);
+    biconjugate_gradient_stabilized<std::complex<double>> solver(system_matrix, system_preconditioner, 1e-12, 1000);
+    auto solution = solver.solve(right_side);
+    EXPECT_TRUE(solver.get_statistics().converged);
+    expect_complex_solution(system_matrix, right_side, solution);
+}
+
+TEST(BiconjugateGradientStabilizedTest, NonsymmetricTest) {
+    sparse_matrix<double> system_matrix(4, 4, {{0, 0, 4.}, {0, 1, -1.}, {1, 0, -2.}, {1, 1, 5.}, {1, 2, 1.},
+                                               {2, 1, -1.}, {2, 2, 3.}, {2, 3, 2.}, {3, 0, 1.}, {3, 3, 6.}});
+    std::vector<double> right_side = {1., -2., 3., 0.5};
+    incomplete_lu_preconditioner<double> system_preconditioner(system_matrix);
+    biconjugate_gradient_stabilized<double> solver(system_matrix, system_preconditioner, 1e-12, 100);
+    auto solution = solver.solve(right_side);
+    EXPECT_TRUE(solver.get_statistics().converged);
+    auto residual = system_matrix.multiply(solution);
+    for (size_t row = 0; row < right_side.size(); row++) {
+        EXPECT_NEAR(right_side[row], residual[row], 1e-10);
+    }
+}
+
+TEST(IncompleteLUPreconditionerTest, ExactTridiagonalTest) {
+    sparse_matrix<double> system_matrix(3, 3, {{0, 0, 2.}, {0, 1, 1.}, {1, 0, -1.}, {1, 1, 3.}, {1, 2, 1.},
+                                               {2, 1, 2.}, {2, 2, 4.}});
+    incomplete_lu_preconditioner<double> system_preconditioner(system_matrix);
+    std::vector<double> right_side = {1., 2., 3.};
+    auto solution = system_preconditioner.apply(right_side);
+    auto residual = system_matrix.multiply(solution);
+    for (size_t row = 0; row < right_side.size(); row++) {
+        EXPECT_NEAR(right_side[row], residual[row], 1e-12);
+    }
+}
+
+TEST(IncompleteLUPreconditionerTest, MissingDiagonalTest) {
+    sparse_matrix<double> system_matrix(2, 2, {{0, 1, 1.}, {1, 0, 1.}});
+    EXPECT_THROW(incomplete_lu_preconditioner<double> system_preconditioner(system_matrix), std::runtime_error);
+}
@@ -69,6 +69,25 @@ TEST(AssignmentTest, MoveAssignmentTest) {
     EXPECT_TRUE(test_matrix.is_equal(expected_matrix));
 }
 
+TEST(StorageTest, ContiguousRowsTest) {
+    matrix<double> test_matrix(5, 6);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(test_matrix[0]) % 64);
+    for (size_t row = 1; row < test_matrix.get_row_number(); row++) {
+        EXPECT_EQ(test_matrix[row - 1] + test_matrix.get_col_number(), test_matrix[row]);
+    }
+}
+
+TEST(StorageTest, SwapRowsTest) {
+    matrix<int> test_matrix(3, 2);
+    fill_int_matrix(test_matrix);
+    test_matrix.swap_rows(0, 2);
+    EXPECT_EQ(2, test_matrix[0][0]);
+    EXPECT_EQ(3, test_matrix[0][1]);
+    EXPECT_EQ(1, test_matrix[1][0]);
+    EXPECT_EQ(0, test_matrix[2][0]);
+    EXPECT_EQ(1, test_matrix[2][1]);
+}
+
 TEST(ArithmeticsTest, OperatorPlusAssignTest) {
     matrix<int> base_matrix(5, 6);
     fill_int_matrix(base_matrix);
@@ -207,6 +226,91 @@ TEST(InverseMatrixTest, InverseThrowsExceptionTest) {
     EXPECT_THROW(test_matrix.inverse(), std::runtime_error);
 }
 
+TEST(SolveTest, SolveTest) {
+    matrix<double> test_matrix(3, 3);
+    test_matrix[0][0] = -1.;
+    test_matrix[0][1] = 2.;
+    test_matrix[0][2] = -2.;
+    test_matrix[1][0] = 2.;
+    test_matrix[1][1] = -1.;
+    test_matrix[1][2] = 5.;
+    test_matrix[2][0] = 3.;
+    test_matrix[2][1] = -2.;
+    test_matrix[2][2] = 4.;
+    matrix<double> right_side(3, 1);
+    right_side[0][0] = 1.;
+    right_side[1][0] = 2.;
+    right_side[2][0] = 3.;
+    matrix<double> expected_solution(3, 1);
+    expected_solution[0][0] = 2.2;
+    expected_solution[1][0] = 1.4;
+    expected_solution[2][0] = -0.2;
+    EXPECT_TRUE(test_matrix.solve(right_side).is_equal(expected_solution));
+}
+
+TEST(SolveTest, FactorizationReuseTest) {
+    matrix<double> test_matrix(2, 2);
+    test_matrix[0][0] = 4.;
+    test_matrix[0][1] = 3.;
+    test_matrix[1][0] = 6.;
+    test_matrix[1][1] = 3.;
+    auto factorization = test_matrix.factorize();
+    matrix<double> first_right_side(2, 1);
+    first_right_side[0][0] = 10.;
+    first_right_side[1][0] = 12.;
+    matrix<double> second_right_side(2, 2);
+    second_right_side[0][0] = 1.;
+    second_right_side[1][1] = 1.;
+    matrix<double> expected_solution(2, 1);
+    expected_solution[0][0] = 1.;
+    expected_solution[1][0] = 2.;
+    EXPECT_TRUE(factorization.solve(first_right_side).is_equal(expected_solution));
+    EXPECT_TRUE(factorization.solve(second_right_side).is_equal(test_matrix.inverse()));
+    EXPECT_DOUBLE_EQ(-6., factorization.get_determinant());
+}
+
+TEST(SolveTest, SolveThrowsExceptionTest) {
+    matrix<double> test_matrix(2, 2);
+    matrix<double> right_side(3, 1);
+    test_matrix[0][0] = 1.;
+    test_matrix[1][1] = 1.;
+    EXPECT_THROW(test_matrix.solve(right_side), std::runtime_error);
+    EXPECT_THROW(matrix<double>(2, 3).factorize(), std::runtime_error);
+}
+
+TEST(SolveTest, ZeroLeadingElementTest) {
+    matrix<double> test_matrix(3, 3);
+    test_matrix[0][1] = 1.;
+    test_matrix[1][0] = 2.;
+    test_matrix[1][2] = 1.;
+    test_matrix[2][2] = 3.;
+    matrix<double> right_side(3, 1);
+    right_side[0][0] = 1.;
+    right_side[1][0] = 3.;
+    right_side[2][0] = 3.;
+    matrix<double> expected_solution(3, 1);
+    expected_solution[0][0] = 1.;
+    expected_solution[1][0] = 1.;
+    expected_solution[2][0] = 1.;
+    EXPECT_TRUE(test_matrix.solve(right_side).is_equal(expected_solution));
+    EXPECT_DOUBLE_EQ(-6., test_matrix.get_determinant());
+}
+
+TEST(SolveTest, SingularMatrixRankTest) {
+    matrix<double> test_matrix(3, 3);
+    test_matrix[0][0] = 1.;
+    test_matrix[0][1] = 2.;
+    test_matrix[1][0] = 2.;
+    test_matrix[1][1] = 4.;
+    test_matrix[2][2] = 1.;
+    auto factorization = test_matrix.factorize();
+    EXPECT_TRUE(factorization.is_singular());
+    EXPECT_EQ(2, factorization.get_rank());
+    EXPECT_EQ(std::vector<size_t>{1}, factorization.get_singular_columns());
+    EXPECT_DOUBLE_EQ(0., factorization.get_determinant());
+    EXPECT_THROW(factorization.solve(matrix<double>(3, 1)), matrix<double>::ZeroDivisionException);
+}
+
 TEST(ComplexMatrixTest, PlusEqualTest) {
     matrix<std::complex<double>> test_matrix(2, 2);
     test_matrix[0][0] = {1, 1};
@@ -254,7 +358,7 @@ TEST(ComplexMatrixTest, DeterminantTest) {
     test_matrix[1][0] = {3, -1.5};
     test_matrix[1][1] = {4, 0};
     std::complex<double> expected_determinant(-5, -3);
-    EXPECT_EQ(test_matrix.get_determinant(), expected_determinant);
+    EXPECT_NEAR(0., std::abs(test_matrix.get_determinant() - expected_determinant), 1e-12);
 }
 
 TEST(ComplexMatrixTest, InverseTest) {
@@ -283,4 +387,57 @@ TEST(ComplexMatrixTest, InverseTest) {
 //TEST(BadAllocationTest, CopyAssignmentThrowsBadAllocationTest) {
 //    matrix<double> test_matrix(50000, 50000), copy_test_matrix;
 //    EXPECT_THROW(copy_test_matrix = test_matrix, std::bad_alloc);
-//}
\ No newline at end of file
+//}
+
+matrix<double> get_symmetric_positive_definite_matrix() {
+    matrix<double> result(3, 3);
+    double elements[3][3] = {{4., -1., -2.}, {-1., 3., -1.}, {-2., -1., 5.}};
+    for (size_t row = 0; row < 3; row++) {
+        for (size_t col = 0; col < 3; col++) {
+            result[row][col] = elements[row][col];
+        }
+    }
+    return result;
+}
+
+TEST(SymmetricFactorizationTest, CholeskySolveTest) {
+    auto test_matrix = get_symmetric_positive_definite_matrix();
+    matrix<double> right_side(3, 2);
+    right_side[0][0] = 1.;
+    right_side[2][0] = -3.;
+    right_side[1][1] = 2.;
+    cholesky_factorization<double> factorization(test_matrix);
+    EXPECT_FALSE(factorization.is_singular());
+    EXPECT_TRUE(test_matrix.solve(right_side).is_equal(factorization.solve(right_side)));
+}
+
+TEST(SymmetricFactorizationTest, CholeskyIndefiniteTest) {
+    auto test_matrix = get_symmetric_positive_definite_matrix();
+    test_matrix[2][2] = -5.;
+    cholesky_factorization<double> factorization(test_matrix);
+    EXPECT_TRUE(factorization.is_singular());
+    EXPECT_THROW(factorization.solve(matrix<double>(3, 1)), matrix<double>::ZeroDivisionException);
+}
+
+TEST(SymmetricFactorizationTest, ComplexLdlSolveTest) {
+    matrix<std::complex<double>> test_matrix(3, 3);
+    test_matrix[0][0] = {2., 1.};
+    test_matrix[0][1] = test_matrix[1][0] = {0., -1.};
+    test_matrix[1][1] = {1., -3.};
+    test_matrix[1][2] = test_matrix[2][1] = {-1., 0.};
+    test_matrix[2][2] = {3., 2.};
+    matrix<std::complex<double>> right_side(3, 1);
+    right_side[0][0] = {1., 1.};
+    right_side[2][0] = {0., -2.};
+    ldl_factorization<std::complex<double>> factorization(test_matrix);
+    EXPECT_FALSE(factorization.is_singular());
+    EXPECT_TRUE(test_matrix.solve(right_side).is_equal(factorization.solve(right_side)));
+}
+
+TEST(SymmetricFactorizationTest, LdlZeroPivotTest) {
+    matrix<double> test_matrix(2, 2);
+    test_matrix[0][1] = test_matrix[1][0] = 1.;
+    ldl_factorization<double> factorization(test_matrix);
+    EXPECT_TRUE(factorization.is_singular());
+    EXPECT_FALSE(test_matrix.factorize().is_singular());
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <sstream>
+
+#include "../netlist_reader.h"
+
+static netlist_reader::edges parse_sequentially(const std::string& input) {
+    netlist_reader::edges edges;
+    input_parser parser(input);
+    while (!parser.is_eof()) {
+        parser.make_iteration();
+        auto edge = parser.get_current_edge_info();
+        if (!parser.is_emf_included())
+            edge.emf = 0.;
+        edges.push_back(edge);
+    }
+    return edges;
+}
+
+static std::string get_dc_netlist(size_t edge_number) {
+    std::stringstream netlist;
+    for (size_t edge = 0; edge < edge_number; edge++) {
+        netlist << edge % 97 + 1 << " -- " << edge % 89 + 2 << ", " << edge % 13 + 0.25 << ";";
+        if (edge % 3 == 0)
+            netlist << " " << edge % 7 << ".5V;";
+        netlist << (edge % 5 == 0 ? " " : "\n");
+        if (edge % 11 == 0)
+            netlist << "\n  \t";
+    }
+    return netlist.str();
+}
+
+static void expect_same_edges(const netlist_reader::edges& expected, const netlist_reader::edges& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t edge = 0; edge < expected.size(); edge++) {
+        EXPECT_EQ(expected[edge].outcoming_vertex, actual[edge].outcoming_vertex);
+        EXPECT_EQ(expected[edge].incoming_vertex, actual[edge].incoming_vertex);
+        EXPECT_EQ(expected[edge].resistance, actual[edge].resistance);
+        EXPECT_EQ(expected[edge].emf, actual[edge].emf);
+    }
+}
+
+static netlist_reader::edges read_edges(netlist_reader& reader, const std::string& input, bool is_stream) {
+    netlist_reader::edges edges;
+    auto consume = [&edges](const netlist_reader::edges& chunk_edges) {
+        edges.insert(edges.end(), chunk_edges.begin(), chunk_edges.end());
+    };
+    if (is_stream) {
+        std::istringstream stream(input);
+        reader.read(stream, consume);
+    } else {
+        reader.read(std::string_view(input), consume);
+    }
+    return edges;
+}
+
+TEST(NetlistReaderTest, ChunkedDcNetlistTest) {
+    const auto netlist = get_dc_netlist(5000);
+    netlist_reader reader(4, 256);
+    expect_same_edges(parse_sequentially(netlist), read_edges(reader, netlist, false));
+    EXPECT_FALSE(reader.is_alternating_current());
+}
+
+TEST(NetlistReaderTest, ChunkedAcNetlistTest) {
+    std::stringstream netlist;
+    for (size_t edge = 0; edge < 3000; edge++) {
+        netlist << edge % 31 + 1 << " -- " << edge % 37 + 1 << ", " << edge % 5 << "R; 0.5C; " << edge % 3 << "L;";
+        if (edge % 2 == 0)
+            netlist << " 220V, " << edge % 120 << ";";
+        netlist << "\n";
+    }
+    netlist_reader reader(3, 128);
+    expect_same_edges(parse_sequentially(netlist.str()), read_edges(reader, netlist.str(), false));
+    EXPECT_TRUE(reader.is_alternating_current());
+}
+
+TEST(NetlistReaderTest, StreamedBlocksTest) {
+    const auto netlist = get_dc_netlist(5000);
+    for (size_t block_size : {7, 100, 4096}) {
+        netlist_reader reader(4, 64, block_size);
+        expect_same_edges(parse_sequentially(netlist), read_edges(reader, netlist, true));
+    }
+}
+
+TEST(NetlistReaderTest, EdgesAcrossLinesTest) {
+    std::string netlist;
+    for (size_t edge = 1; edge < 500; edge++) {
+        netlist += std::to_string(edge) + "\n-- " + std::to_string(edge + 1) + ",\n0.5;\n";
+        if (edge % 2)
+            netlist += "3V;\n";
+    }
+    netlist_reader chunk_reader(4, 32);
+    expect_same_edges(parse_sequentially(netlist), read_edges(chunk_reader, netlist, false));
+    netlist_reader block_reader(4, 32, 50);
+    expect_same_edges(parse_sequentially(netlist), read_edges(block_reader, netlist, true));
+}
+
+TEST(NetlistReaderTest, InvalidInputPositionTest) {
+    auto netlist = get_dc_netlist(1000);
+    const size_t line_number = std::count(netlist.begin(), netlist.end(), '\n');
+    netlist += "1 -- 2, 0.5; 4 -- 5, x1;\n" + get_dc_netlist(100);
+    for (size_t block_size : {16, 1 << 20}) {
+        netlist_reader reader(4, 64, block_size);
+        size_t edge_number = 0;
+        try {
+            std::istringstream stream(netlist);
+            reader.read(stream, [&edge_number](const netlist_reader::edges& edges) { edge_number += edges.size(); });
+            FAIL();
+        } catch (const input_parser::InvalidInputException& exception) {
+            EXPECT_EQ('x', exception.get_character());
+            EXPECT_EQ(line_number + 1, exception.get_line());
+            EXPECT_EQ(22, exception.get_column());
+        }
+        EXPECT_EQ(1001, edge_number);
+    }
+}
+
+TEST(NetlistReaderTest, EmptyInputTest) {
+    netlist_reader reader(4, 1);
+    EXPECT_TRUE(read_edges(reader, "", false).empty());
+    EXPECT_TRUE(read_edges(reader, "", true).empty());
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <complex>
+#include "../network_reduction.h"
+
+TEST(NetworkReductionTest, SeriesLoopTest) {
+    graph test_graph;
+    test_graph.add_edge(0, 1);
+    test_graph.add_edge(1, 2);
+    test_graph.add_edge(2, 0);
+    network_reduction<double> reduction(test_graph, {1., 0.5, 1. / 3.}, {6., 0., 0.});
+    EXPECT_EQ(0, reduction.get_reduced_graph().get_edge_number());
+    auto edge_current = reduction.get_edge_current({}, {});
+    ASSERT_EQ(3, edge_current.size());
+    for (auto current : edge_current) {
+        EXPECT_NEAR(1., current, 1e-12);
+    }
+}
+
+TEST(NetworkReductionTest, ParallelBranchesTest) {
+    graph test_graph;
+    test_graph.add_edge(0, 1);
+    test_graph.add_edge(1, 0);
+    network_reduction<double> reduction(test_graph, {1., 1.}, {2., 0.});
+    EXPECT_EQ(0, reduction.get_reduced_graph().get_edge_number());
+    auto edge_current = reduction.get_edge_current({}, {});
+    EXPECT_NEAR(1., edge_current[0], 1e-12);
+    EXPECT_NEAR(1., edge_current[1], 1e-12);
+}
+
+TEST(NetworkReductionTest, SeriesChainInMeshTest) {
+    graph test_graph;
+    test_graph.add_edge(0, 1);
+    test_graph.add_edge(0, 2);
+    test_graph.add_edge(0, 3);
+    test_graph.add_edge(1, 2);
+    test_graph.add_edge(2, 3);
+    test_graph.add_edge(1, 4);
+    test_graph.add_edge(4, 3);
+    network_reduction<double> reduction(test_graph, {1., 1., 1., 1., 1., 2., 2.}, {1., 0., 0., 0., 0., 0., 0.});
+    const auto& reduced_graph = reduction.get_reduced_graph();
+    EXPECT_EQ(6, reduced_graph.get_edge_number());
+    EXPECT_EQ(4, reduced_graph.get_vertex_number());
+    EXPECT_DOUBLE_EQ(1., reduction.get_reduced_conductivity().back());
+
+    std::vector<double> reduced_current(6, 0.), reduced_voltage(6, 0.);
+    reduced_current.back() = 0.25;
+    reduced_voltage.back() = -0.25;
+    auto edge_current = reduction.get_edge_current(reduced_current, reduced_voltage);
+    EXPECT_DOUBLE_EQ(0.25, edge_current[5]);
+    EXPECT_DOUBLE_EQ(0.25, edge_current[6]);
+}
+
+TEST(NetworkReductionTest, ResonantParallelBranchesTest) {
+    typedef std::complex<double> complex;
+    graph test_graph;
+    test_graph.add_edge(0, 1);
+    test_graph.add_edge(0, 1);
+    test_graph.add_edge(0, 2);
+    test_graph.add_edge(0, 3);
+    test_graph.add_edge(1, 2);
+    test_graph.add_edge(1, 3);
+    test_graph.add_edge(2, 3);
+    network_reduction<complex> reduction(test_graph, {complex(0., 1.), complex(0., -1.), 1., 1., 1., 1., 1.},
+                                         {1., 0., 0., 0., 0., 0., 0.});
+    EXPECT_EQ(7, reduction.get_reduced_graph().get_edge_number());
+}
@@ -0,0 +1,214 @@
+#include <gmock/gmock.h>
+#include <complex>
+
+#include "../sparse_matrix.h"
+
+
+
+sparse_matrix<double> get_test_sparse_matrix() {
+    return sparse_matrix<double>(3, 4, {{0, 0, 1.}, {0, 3, 2.}, {1, 1, 3.}, {2, 0, 4.}, {2, 2, 5.}});
+}
+
+TEST(SparseConstructorTest, TripletConstructorTest) {
+    auto test_matrix = get_test_sparse_matrix();
+    EXPECT_EQ(3, test_matrix.get_row_number());
+    EXPECT_EQ(4, test_matrix.get_col_number());
+    EXPECT_EQ(5, test_matrix.get_nonzero_number());
+    EXPECT_EQ(std::vector<uint32_t>({0, 2, 3, 5}), test_matrix.get_row_offsets());
+    EXPECT_EQ(std::vector<uint32_t>({0, 3, 1, 0, 2}), test_matrix.get_col_indices());
+    EXPECT_DOUBLE_EQ(2., test_matrix.get_element(0, 3));
+    EXPECT_DOUBLE_EQ(0., test_matrix.get_element(1, 3));
+}
+
+TEST(SparseConstructorTest, DuplicatesAreSummedTest) {
+    sparse_matrix<double> test_matrix(2, 2, {{1, 1, 1.}, {0, 1, 2.}, {1, 1, 3.}, {1, 0, 4.}});
+    EXPECT_EQ(3, test_matrix.get_nonzero_number());
+    EXPECT_DOUBLE_EQ(4., test_matrix.get_element(1, 1));
+    EXPECT_DOUBLE_EQ(4., test_matrix.get_element(1, 0));
+    EXPECT_EQ(std::vector<uint32_t>({1, 0, 1}), test_matrix.get_col_indices());
+}
+
+TEST(SparseConstructorTest, OutOfRangeTest) {
+    EXPECT_THROW(sparse_matrix<double>(2, 2, {{2, 0, 1.}}), std::runtime_error);
+}
+
+TEST(SparseConstructorTest, DenseConversionTest) {
+    matrix<double> dense_matrix(3, 3);
+    dense_matrix[0][2] = 1.;
+    dense_matrix[1][1] = -2.;
+    dense_matrix[2][0] = 3.;
+    sparse_matrix<double> test_matrix(dense_matrix);
+    EXPECT_EQ(3, test_matrix.get_nonzero_number());
+    EXPECT_TRUE(dense_matrix.is_equal(test_matrix.to_dense()));
+}
+
+TEST(SparseMultiplicationTest, VectorMultiplicationTest) {
+    auto test_matrix = get_test_sparse_matrix();
+    std::vector<double> result = test_matrix.multiply(std::vector<double>({1., 2., 3., 4.}));
+    EXPECT_EQ(std::vector<double>({9., 6., 19.}), result);
+}
+
+TEST(SparseMultiplicationTest, DenseMultiplicationTest) {
+    auto test_matrix = get_test_sparse_matrix();
+    matrix<double> right_matrix(4, 2);
+    for (size_t row = 0; row < 4; row++) {
+        right_matrix[row][0] = row + 1.;
+        right_matrix[row][1] = 1.;
+    }
+    EXPECT_TRUE((test_matrix.to_dense() * right_matrix).is_equal(test_matrix.multiply(right_matrix)));
+}
+
+TEST(SparseMultiplicationTest, TransposedViewTest) {
+    auto test_matrix = get_test_sparse_matrix();
+    auto view = test_matrix.transpose_view();
+    EXPECT_EQ(4, view.get_row_number());
+    EXPECT_EQ(3, view.get_col_number());
+    EXPECT_EQ(std::vector<double>({13., 6., 15., 2.}), view.multiply(std::vector<double>({1., 2., 3.})));
+    EXPECT_EQ(view.multiply(std::vector<double>({1., 2., 3.})),
+              test_matrix.transpose().multiply(std::vector<double>({1., 2., 3.})));
+}
+
+TEST(SparseTransposeTest, TransposeTest) {
+    auto test_matrix = get_test_sparse_matrix();
+    EXPECT_TRUE(test_matrix.to_dense().transpose().is_equal(test_matrix.transpose().to_dense()));
+    EXPECT_EQ(std::vector<uint32_t>({0, 2, 3, 4, 5}), test_matrix.transpose().get_row_offsets());
+}
+
+TEST(SparseLaplacianTest, GraphLaplacianTest) {
+    graph test_graph;
+    test_graph.add_edge(0, 1);
+    test_graph.add_edge(1, 2);
+    test_graph.add_edge(2, 0);
+    test_graph.add_edge(1, 0);
+    auto laplacian = sparse_matrix<double>::laplacian(test_graph, {1., 2., 3., 4.}, 2);
+    EXPECT_EQ(4, laplacian.get_nonzero_number());
+    EXPECT_DOUBLE_EQ(8., laplacian.get_element(0, 0));
+    EXPECT_DOUBLE_EQ(7., laplacian.get_element(1, 1));
+    EXPECT_DOUBLE_EQ(-5., laplacian.get_element(0, 1));
+    EXPECT_DOUBLE_EQ(-5., laplacian.get_element(1, 0));
+}
+
+TEST(SparseLaplacianTest, ComplexLaplacianTest) {
+    graph test_graph;
+    test_graph.add_edge(0, 1);
+    test_graph.add_edge(1, 2);
+    std::vector<std::complex<double>> weights = {{1., 1.}, {0., -2.}};
+    auto laplacian = sparse_matrix<std::complex<double>>::laplacian(test_graph, weights, 3);
+    EXPECT_EQ(7, laplacian.get_nonzero_number());
+    EXPECT_EQ(std::complex<double>(1., -1.), laplacian.get_element(1, 1));
+    EXPECT_EQ(std::complex<double>(0., 2.), laplacian.get_element(2, 1));
+    EXPECT_EQ(std::complex<double>(0., 0.), laplacian.get_element(0, 2));
+}
+
+TEST(SparseLaplacianTest, WrongWeightsTest) {
+    graph test_graph;
+    test_graph.add_edge(0, 1);
+    EXPECT_THROW(sparse_matrix<double>::laplacian(test_graph, {}, 1), std::runtime_error);
+}
+
+sparse_matrix<double> get_grid_laplacian(size_t side) {
+    graph grid;
+    std::vector<double> weights;
+    for (size_t row = 0; row < side; row++) {
+        for (size_t col = 0; col < side; col++) {
+            if (col + 1 < side) {
+                grid.add_edge(row * side + col, row * side + col + 1);
+                weights.push_back(1. + (row + col) % 3);
+            }
+            if (row + 1 < side) {
+                grid.add_edge(row * side + col, (row + 1) * side + col);
+                weights.push_back(2. + col % 2);
+            }
+        }
+    }
+    return sparse_matrix<double>::laplacian(grid, weights, side * side - 1);
+}
+
+TEST(SparseFactorizationTest, GridSolveTest) {
+    auto laplacian = get_grid_laplacian(8);
+    std::vector<double> right_side(laplacian.get_row_number());
+    for (size_t row = 0; row < right_side.size(); row++) {
+        right_side[row] = static_cast<double>(row % 5) - 2.;
+    }
+    auto factorization = laplacian.factorize();
+    EXPECT_FALSE(factorization.is_singular());
+    auto solution = factorization.solve(right_side);
+    auto residual = laplacian.multiply(solution);
+    for (size_t row = 0; row < right_side.size(); row++) {
+        EXPECT_NEAR(right_side[row], residual[row], 1e-10);
+    }
+}
+
+TEST(SparseFactorizationTest, DenseAgreementTest) {
+    auto laplacian = get_grid_laplacian(5);
+    matrix<double> right_side(laplacian.get_row_number(), 2);
+    for (size_t row = 0; row < right_side.get_row_number(); row++) {
+        right_side[row][0] = 1.;
+        right_side[row][1] = static_cast<double>(row);
+    }
+    EXPECT_TRUE(laplacian.to_dense().solve(right_side).is_equal(laplacian.factorize().solve(right_side)));
+}
+
+TEST(SparseFactorizationTest, ComplexSolveTest) {
+    graph test_graph;
+    test_graph.add_edge(0, 1);
+    test_graph.add_edge(1, 2);
+    test_graph.add_edge(2, 3);
+    test_graph.add_edge(3, 0);
+    test_graph.add_edge(0, 2);
+    std::vector<std::complex<double>> weights = {{1., 2.}, {0., -1.}, {3., 0.}, {1., 1.}, {0.5, -0.5}};
+    auto laplacian = sparse_matrix<std::complex<double>>::laplacian(test_graph, weights, 3);
+    matrix<std::complex<double>> right_side(3, 1);
+    right_side[0][0] = {1., 0.};
+    right_side[2][0] = {0., -2.};
+    auto factorization = laplacian.factorize();
+    EXPECT_FALSE(factorization.is_singular());
+    EXPECT_TRUE(laplacian.to_dense().solve(right_side).is_equal(factorization.solve(right_side)));
+}
+
+TEST(SparseFactorizationTest, MinimumDegreeOrderingTest) {
+    graph star;
+    for (size_t leaf = 1; leaf <= 20; leaf++) {
+        star.add_edge(0, leaf);
+    }
+    auto laplacian = sparse_matrix<double>::laplacian(star, std::vector<double>(20, 1.), 20);
+    auto factorization = laplacian.factorize();
+    EXPECT_NE(0, factorization.get_permutation().front());
+    EXPECT_EQ(19, factorization.get_factor_nonzero_number());
+}
+
+TEST(SparseFactorizationTest, SingularMatrixTest) {
+    graph test_graph;
+    test_graph.add_edge(0, 1);
+    test_graph.add_edge(1, 2);
+    auto laplacian = sparse_matrix<double>::laplacian(test_graph, {1., 1.}, 3);
+    auto factorization = laplacian.factorize();
+    EXPECT_TRUE(factorization.is_singular());
+    EXPECT_THROW(factorization.solve(std::vector<double>(3, 0.)), matrix<double>::ZeroDivisionException);
+}
+
+TEST(SparseFactorizationTest, RefactorizeTest) {
+    auto laplacian = get_grid_laplacian(4);
+    auto factorization = laplacian.factorize();
+    auto scaled = sparse_matrix<double>(laplacian.to_dense());
+    for (size_t row = 0; row < scaled.get_row_number(); row++) {
+        *scaled.find_element(row, row) += 1.;
+    }
+    factorization.refactorize(scaled);
+    std::vector<double> right_side(scaled.get_row_number(), 1.);
+    auto residual = scaled.multiply(factorization.solve(right_side));
+    for (size_t row = 0; row < right_side.size(); row++) {
+        EXPECT_NEAR(1., residual[row], 1e-10);
+    }
+}
+
+TEST(SparseMultiplicationTest, SparseMultiplicationTest) {
+    auto test_matrix = get_test_sparse_matrix();
+    auto transposed = test_matrix.transpose();
+    auto product = test_matrix.multiply(transposed);
+    EXPECT_EQ(3, product.get_row_number());
+    EXPECT_EQ(3, product.get_col_number());
+    EXPECT_TRUE((test_matrix.to_dense() * transposed.to_dense()).is_equal(product.to_dense()));
+    EXPECT_EQ(std::vector<uint32_t>({0, 2, 3, 5}), product.get_row_offsets());
+    EXPECT_THROW(test_matrix.multiply(test_matrix), std::runtime_error);
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include "../thread_pool.h"
+
+TEST(ThreadPoolTest, ThreadNumberTest) {
+    thread_pool pool(3);
+    EXPECT_EQ(3, pool.get_thread_number());
+    thread_pool single_thread_pool(0);
+    EXPECT_EQ(1, single_thread_pool.get_thread_number());
+}
+
+TEST(ThreadPoolTest, AllTasksCompletedTest) {
+    std::vector<size_t> results(100);
+    {
+        thread_pool pool(4);
+        std::vector<std::future<void>> futures;
+        for (size_t task_index = 0; task_index < results.size(); task_index++) {
+            futures.push_back(pool.submit([&results, task_index] { results[task_index] = task_index * task_index; }));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+    }
+    for (size_t task_index = 0; task_index < results.size(); task_index++) {
+        EXPECT_EQ(task_index * task_index, results[task_index]);
+    }
+}
+
+TEST(ThreadPoolTest, PendingTasksCompletedOnDestructionTest) {
+    std::atomic<size_t> completed_tasks(0);
+    {
+        thread_pool pool(2);
+        for (size_t task_index = 0; task_index < 50; task_index++) {
+            pool.submit([&completed_tasks] { completed_tasks++; });
+        }
+    }
+    EXPECT_EQ(50, completed_tasks.load());
+}
+
+TEST(ThreadPoolTest, ExceptionPropagationTest) {
+    thread_pool pool(2);
+    auto future = pool.submit([] { throw std::runtime_error("task failed"); });
+    EXPECT_THROW(future.get(), std::runtime_error);
+    auto next_future = pool.submit([] {});
+    EXPECT_NO_THROW(next_future.get());
+}
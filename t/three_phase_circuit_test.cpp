@@ -54,9 +54,9 @@ TEST(CalculationTest, DCCircuit5Test) {
     generate_calculation_test("include dc_test2.txt\n\nResistance1(1, 2)\nResistance0(1, 6)\nResistance2(2, 3)\nResistance2(2, 7)\nResistance2(3, 4)\nResistance2(3, 8)\nResistance1(4, 5)\nResistance2(4, 9)\nResistance0(5, 10)\n"
                               "Resistance1(6, 7)\nResistance0(6, 11)\nResistance2(7, 8)\nResistance2(7, 12)\nResistance2(8, 9)\nResistance2(8, 13)\nResistance1(9, 10)\nResistance2(9, 14)\nResistance0(10, 15)\n"
                               "Resistance1(11, 12)\nResistance2(12, 13)\nResistance2(13, 14)\nResistance1(14, 15)\nResistance0(11, 16)\nResistance0(15, 20)\n\nVoltage(20, 16)",
-                              "1 -- 2: 20 A, 0;\n1 -- 6: 20 A, 180;\n2 -- 3: 20 A, 0;\n2 -- 7: 5.83329e-09 A, 180;\n3 -- 4: 20 A, 0;\n3 -- 8: 1.06581e-14 A, 180;\n4 -- 5: 20 A, 0;\n"
-                              "4 -- 9: 5.83333e-09 A, 0;\n5 -- 10: 20 A, 0;\n6 -- 7: 20 A, 0;\n6 -- 11: 40.0001 A, 180;\n7 -- 8: 20 A, 0;\n7 -- 12: 9.16673e-09 A, 180;\n8 -- 9: 20 A, 0;\n"
-                              "8 -- 13: 1.06581e-14 A, 180;\n9 -- 10: 20 A, 0;\n9 -- 14: 9.16665e-09 A, 0;\n10 -- 15: 40 A, 0;\n11 -- 12: 20 A, 0;\n11 -- 16: 60 A, 180;\n12 -- 13: 20 A, 0;\n"
+                              "1 -- 2: 20 A, 0;\n1 -- 6: 20 A, 180;\n2 -- 3: 20 A, 0;\n2 -- 7: 5.83335e-09 A, 180;\n3 -- 4: 20 A, 0;\n3 -- 8: 3.55271e-15 A, 180;\n4 -- 5: 20 A, 0;\n"
+                              "4 -- 9: 5.83333e-09 A, 0;\n5 -- 10: 20 A, 0;\n6 -- 7: 20 A, 0;\n6 -- 11: 40 A, 180;\n7 -- 8: 20 A, 0;\n7 -- 12: 9.16665e-09 A, 180;\n8 -- 9: 20 A, 0;\n"
+                              "8 -- 13: 0 A, 0;\n9 -- 10: 20 A, 0;\n9 -- 14: 9.16667e-09 A, 0;\n10 -- 15: 40 A, 0;\n11 -- 12: 20 A, 0;\n11 -- 16: 60 A, 180;\n12 -- 13: 20 A, 0;\n"
                               "13 -- 14: 20 A, 0;\n14 -- 15: 20 A, 0;\n15 -- 20: 60 A, 0;\n20 -- 16: 60 A, 0;");
 }
 
@@ -113,8 +113,8 @@ TEST(CalculationTest, TPCircuitTest) {
                               "1 -- 4: 3.60462 A, -34.992;\n"
                               "2 -- 4: 4.4 A, -120;\n"
                               "3 -- 4: 6.28571 A, 30;\n"
-                              "5 -- 1: 3.60464 A, -34.9918;\n"
-                              "5 -- 2: 4.39999 A, -120;\n"
-                              "5 -- 3: 6.2857 A, 30.0002;\n"
-                              "5 -- 4: 6.28571 A, -150;");
+                              "5 -- 1: 3.60462 A, -34.992;\n"
+                              "5 -- 2: 4.4 A, -120;\n"
+                              "5 -- 3: 6.28572 A, 30;\n"
+                              "5 -- 4: 6.77325 A, 156.187;");
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "thread_pool.h"
+
+thread_pool::thread_pool(size_t thread_number) {
+    if (!thread_number)
+        thread_number = 1;
+    workers.reserve(thread_number);
+    for (size_t thread_index = 0; thread_index < thread_number; thread_index++) {
+        workers.emplace_back(&thread_pool::work, this);
+    }
+}
+
+thread_pool::~thread_pool() {
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex);
+        is_stopped = true;
+    }
+    tasks_condition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+std::future<void> thread_pool::submit(std::function<void()> task) {
+    std::packaged_task<void()> packaged_task(std::move(task));
+    auto result = packaged_task.get_future();
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex);
+        tasks.push(std::move(packaged_task));
+    }
+    tasks_condition.notify_one();
+    return result;
+}
+
+size_t thread_pool::get_default_thread_number() {
+    const size_t thread_number = std::thread::hardware_concurrency();
+    return thread_number ? thread_number : 1;
+}
+
+void thread_pool::work() {
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(tasks_mutex);
+            tasks_condition.wait(lock, [this] { return is_stopped || !tasks.empty(); });
+            if (tasks.empty())
+                return;
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef CIRCUITS_THREAD_POOL_H
+#define CIRCUITS_THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+class thread_pool {
+public:
+    explicit thread_pool(size_t thread_number = get_default_thread_number());
+    ~thread_pool();
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    std::future<void> submit(std::function<void()> task);
+    size_t get_thread_number() const { return workers.size(); }
+
+    static size_t get_default_thread_number();
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::packaged_task<void()>> tasks;
+    std::mutex tasks_mutex;
+    std::condition_variable tasks_condition;
+    bool is_stopped = false;
+
+    void work();
+};
+
+#endif //CIRCUITS_THREAD_POOL_H
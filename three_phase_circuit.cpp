@@ -1,22 +1,69 @@
 #include <fstream>
 #include "circuit.h"
+#include "element_library.h"
+
+static int compile_element_library(const std::string& source_file_name, const std::string& library_file_name) {
+    std::ifstream source_file(source_file_name);
+    if (!source_file.is_open()) {
+        std::cout << "File " << source_file_name << " failed to open" << std::endl;
+        return 2;
+    }
+    std::ofstream library_file(library_file_name, std::ios::binary);
+    if (!library_file.is_open()) {
+        std::cout << "File " << library_file_name << " failed to open" << std::endl;
+        return 2;
+    }
+    try {
+        element_library::compile(source_file, source_file_name, library_file);
+    } catch (const element_library::NotOnlyDefinitionsException&) {
+        std::cout << "Library " << source_file_name << " must contain element definitions only" << std::endl;
+        return 1;
+    }
+    return 0;
+}
 
 int main(int argc, char* argv[]) {
-    if (argc > 2) {
+    solver_options options;
+    std::vector<std::string> file_names;
+    std::string library_file_name;
+    for (int argument = 1; argument < argc; argument++) {
+        if (std::string(argv[argument]) == "--compile-library" && argument + 1 < argc) {
+            library_file_name = argv[++argument];
+            continue;
+        }
+        const auto status = parse_solver_option(argument, argc, argv, options);
+        if (status == option_status::invalid) {
+            std::cout << "Invalid argument: " << argv[argument - 1] << " " << argv[argument] << std::endl;
+            return 1;
+        }
+        if (status == option_status::not_option)
+            file_names.emplace_back(argv[argument]);
+    }
+    if (!library_file_name.empty()) {
+        if (file_names.size() != 1) {
+            std::cout << "Invalid number of arguments: library source file required" << std::endl;
+            return 1;
+        }
+        return compile_element_library(file_names[0], library_file_name);
+    }
+    if (file_names.size() > 1) {
         std::cout << "Invalid number of arguments: only input file required" << std::endl;
         return 1;
     }
-    if (argc == 2) {
+    std::vector<solver_statistics> statistics;
+    if (file_names.size() == 1) {
         std::ifstream input_file;
-        input_file.open(argv[1]);
+        input_file.open(file_names[0]);
         if (!input_file.is_open()) {
-            std::cout << "File " << argv[1] << " failed to open" << std::endl;
+            std::cout << "File " << file_names[0] << " failed to open" << std::endl;
             return 2;
         }
-        calculate_complex_circuit<std::complex<double>>(input_file, argv[1]);
+        statistics = calculate_complex_circuit<std::complex<double>>(input_file, file_names[0], std::cout, options);
         input_file.close();
-        return 0;
+    } else {
+        statistics = calculate_complex_circuit<std::complex<double>>(std::cin, "input", std::cout, options);
     }
-    calculate_complex_circuit<std::complex<double>>();
+    if (options.solver != solver_options::method::direct)
+        print_solver_statistics(statistics);
     return 0;
 }